@@ -22,10 +22,14 @@ import com.google.firebase.crashlytics.internal.Logger;
 import com.google.firebase.crashlytics.internal.common.CommonUtils;
 import java.io.BufferedWriter;
 import java.io.File;
+import java.io.FileInputStream;
 import java.io.FileOutputStream;
 import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
 import java.io.OutputStreamWriter;
 import java.nio.charset.Charset;
+import java.util.zip.GZIPInputStream;
 
 class CrashpadController implements NativeComponentController {
 
@@ -88,6 +92,8 @@ class CrashpadController implements NativeComponentController {
     Logger.getLogger()
         .v("Minidump directory: " + sessionFileDirectoryForMinidump.getAbsolutePath());
 
+    decompressMinidump(sessionFileDirectoryForMinidump);
+
     File minidump = getSingleFileWithExtension(sessionFileDirectoryForMinidump, ".dmp");
 
     Logger.getLogger()
@@ -185,6 +191,47 @@ class CrashpadController implements NativeComponentController {
     }
   }
 
+  /**
+   * Restores a gzip-compressed minidump in the given directory to its original name, so the
+   * standard .dmp lookup finds it. The native handler optionally compresses pending dumps; see
+   * CRASHLYTICS_COMPRESS_MINIDUMPS in the NDK config.
+   */
+  private static void decompressMinidump(File directory) {
+    final File compressed = getSingleFileWithExtension(directory, ".dmp.gz");
+    if (compressed == null) {
+      return;
+    }
+
+    final String compressedName = compressed.getName();
+    final File minidump =
+        new File(directory, compressedName.substring(0, compressedName.length() - ".gz".length()));
+
+    boolean decompressed = false;
+    InputStream input = null;
+    OutputStream output = null;
+    try {
+      input = new GZIPInputStream(new FileInputStream(compressed));
+      output = new FileOutputStream(minidump);
+      final byte[] buffer = new byte[8192];
+      int read;
+      while ((read = input.read(buffer)) != -1) {
+        output.write(buffer, 0, read);
+      }
+      decompressed = true;
+    } catch (IOException e) {
+      Logger.getLogger().e("Error decompressing minidump " + compressed, e);
+    } finally {
+      CommonUtils.closeOrLog(input, "Failed to close " + compressed);
+      CommonUtils.closeOrLog(output, "Failed to close " + minidump);
+    }
+
+    if (decompressed) {
+      compressed.delete();
+    } else {
+      minidump.delete();
+    }
+  }
+
   /** Returns a single file matching the given extension from the given directory. */
   @Nullable
   private static File getSingleFileWithExtension(File directory, String extension) {
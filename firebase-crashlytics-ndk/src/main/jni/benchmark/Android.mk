@@ -0,0 +1,30 @@
+LOCAL_PATH := $(call my-dir)
+
+# On-device microbenchmarks; not part of the shipping artifact. Build with
+#     ndk-build CRASHLYTICS_BENCHMARKS=1
+# then push and run the crashlytics-benchmark binary per ABI.
+ifdef CRASHLYTICS_BENCHMARKS
+
+include $(CLEAR_VARS)
+
+LOCAL_MODULE := crashlytics-benchmark
+LOCAL_C_INCLUDES := \
+    $(LOCAL_PATH)/../libcrashlytics/include \
+    $(LOCAL_PATH)/../libcrashlytics-common/include \
+
+LOCAL_CPPFLAGS := \
+    -std=c++17 \
+    -Wall \
+    -O2 \
+    -fno-exceptions \
+    -fno-rtti \
+
+LOCAL_LDLIBS := -llog
+
+LOCAL_SRC_FILES := benchmark.cpp
+
+LOCAL_SHARED_LIBRARIES := crashlytics-common
+
+include $(BUILD_EXECUTABLE)
+
+endif
@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! On-device microbenchmarks for the hot primitives of the common library.
+//  Build with CRASHLYTICS_BENCHMARKS=1 and run the resulting
+//  crashlytics-benchmark binary per ABI (armeabi-v7a, arm64-v8a) from adb.
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "crashlytics/detail/format.h"
+#include "crashlytics/detail/lexical_cast.h"
+#include "crashlytics/detail/scoped_writer.h"
+#include "crashlytics/detail/system_info.h"
+#include "crashlytics/detail/memory/allocator.h"
+#include "crashlytics/detail/memory/pool_allocator.h"
+#include "crashlytics/external/detail/log_buffer.h"
+
+#include "upbench.h"
+
+//! uint64 -> decimal conversion, the inner loop of every numeric field the
+//  writers emit.
+UP_BENCH(lexical_cast_uint64, 4000000u)
+{
+    char buffer[20];
+
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        upbench::consume(google::crashlytics::detail::lexical_cast(i * 2654435761u, buffer));
+    }
+}
+
+//! The digit-pair conversion that replaced lexical_cast on the write path; the
+//  gap between the two is widest on cores without fast hardware divide.
+UP_BENCH(format_decimal_uint64, 4000000u)
+{
+    char buffer[google::crashlytics::detail::maximum_decimal_length];
+
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        upbench::consume(google::crashlytics::detail::format_to(buffer, i * 2654435761u));
+    }
+}
+
+//! A representative device-info-sized JSON document, buffered and flushed to
+//  /dev/null; wall time per document includes the open and the final flush.
+UP_BENCH(scoped_writer_document, 20000u)
+{
+    using google::crashlytics::detail::scoped_writer;
+
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        int fd = ::open("/dev/null", O_WRONLY);
+        if (fd == -1) {
+            return;
+        }
+
+        scoped_writer writer(fd);
+        scoped_writer::wrapped object('{', '}', scoped_writer::None, writer);
+
+        writer.write("orientation",                i,     scoped_writer::Comma);
+        writer.write("total_physical_memory",      i * 7, scoped_writer::Comma);
+        writer.write("total_internal_storage",     i * 5, scoped_writer::Comma);
+        writer.write("available_physical_memory",  i * 3, scoped_writer::Comma);
+        writer.write("available_internal_storage", i * 2, scoped_writer::Comma);
+        writer.write("battery",                    i % 100u, scoped_writer::Comma);
+        writer.write("proximity_enabled",          false, scoped_writer::None);
+    }
+}
+
+//! Raw mmap-backed allocation latency, one page-sized block at a time.
+UP_BENCH(page_allocator_roundtrip, 100000u)
+{
+    struct page_sized { char storage[4096]; };
+
+    google::crashlytics::detail::memory::page_allocator<page_sized> allocator;
+
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        page_sized* block = allocator.allocate(1);
+
+        if (block == nullptr) {
+            return;
+        }
+
+        block->storage[0] = static_cast<char>(i);
+        upbench::consume(static_cast<uint64_t>(block->storage[0]));
+
+        allocator.deallocate(block, sizeof (page_sized));
+    }
+}
+
+//! Small-object churn through the size-class pool; after the first few carves
+//  this is a freelist pop and push per iteration, with no further mappings.
+UP_BENCH(pool_allocator_small_objects, 1000000u)
+{
+    struct breadcrumb_sized { char storage[64]; };
+
+    google::crashlytics::detail::memory::pool_allocator<breadcrumb_sized> allocator;
+
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        breadcrumb_sized* block = allocator.allocate(1);
+
+        if (block == nullptr) {
+            return;
+        }
+
+        block->storage[0] = static_cast<char>(i);
+        upbench::consume(static_cast<uint64_t>(block->storage[0]));
+
+        allocator.deallocate(block, 1u);
+    }
+}
+
+//! The /proc/meminfo open-parse-close cycle behind memory_statistics; uses the
+//  undeadlined collector so the probe thread isn't part of the measurement.
+UP_BENCH(proc_meminfo_parse, 20000u)
+{
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        auto statistics = google::crashlytics::detail::memory_statistics_now();
+        upbench::consume(statistics.first + statistics.second);
+    }
+}
+
+//! Producer/consumer round-trip through the lock-free ring that backs
+//  external_api_log; the JNI hop on the drain side is excluded, as it needs a
+//  JVM this binary doesn't have.
+UP_BENCH(log_buffer_roundtrip, 1000000u)
+{
+    static google::crashlytics::api::detail::log_buffer buffer;
+
+    const char message[] = "benchmark breadcrumb payload, representative length";
+
+    for (uint64_t i = 0; i < up_iterations; ++i) {
+        buffer.push(message, sizeof message - 1u);
+        buffer.pop([](const char* data, std::size_t length) {
+            upbench::consume(static_cast<uint64_t>(data[0]) + length);
+        });
+    }
+}
+
+UP_BENCH_MAIN()
@@ -0,0 +1,111 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_BENCHMARK_UPBENCH_H__
+#define __CRASHLYTICS_BENCHMARK_UPBENCH_H__
+
+//! A single-header microbenchmark harness in the spirit of test/upp11.h:
+//  register a body with UP_BENCH(name, iterations), emit the binary's main
+//  with UP_BENCH_MAIN(). Each body receives its iteration count and runs its
+//  own loop; the harness times the call and reports per-iteration cost, so
+//  numbers compare directly across ABIs.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+
+namespace upbench {
+
+typedef void (*benchmark_function)(uint64_t iterations);
+
+struct entry {
+    const char*        name;
+    benchmark_function function;
+    uint64_t           iterations;
+};
+
+constexpr std::size_t registry_capacity = 64u;
+
+inline entry* registry()
+{
+    static entry entries[registry_capacity];
+    return entries;
+}
+
+inline std::size_t& registered()
+{
+    static std::size_t count = 0;
+    return count;
+}
+
+struct registrar {
+    registrar(const char* name, benchmark_function function, uint64_t iterations)
+    {
+        if (registered() < registry_capacity) {
+            registry()[registered()++] = { name, function, iterations };
+        }
+    }
+};
+
+inline uint64_t now_nanoseconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000u + static_cast<uint64_t>(now.tv_nsec);
+}
+
+//! Defeats dead-code elimination of a computed value.
+inline void consume(uint64_t value)
+{
+    static volatile uint64_t sink;
+    sink = value;
+    (void) sink;
+}
+
+inline int run()
+{
+    for (std::size_t i = 0; i < registered(); ++i) {
+        const entry& benchmark = registry()[i];
+
+        //! One untimed pass through a fraction of the workload warms caches
+        //  and lazily-initialized state out of the measurement.
+        benchmark.function(benchmark.iterations / 16u + 1u);
+
+        uint64_t started = now_nanoseconds();
+        benchmark.function(benchmark.iterations);
+        uint64_t elapsed = now_nanoseconds() - started;
+
+        std::printf("%-32s %10llu iterations %10.3f ms %10.1f ns/op\n",
+                benchmark.name,
+                static_cast<unsigned long long>(benchmark.iterations),
+                elapsed / 1e6,
+                static_cast<double>(elapsed) / benchmark.iterations);
+    }
+
+    return 0;
+}
+
+} // namespace upbench
+
+#define UP_BENCH(benchname, benchiterations) \
+    static void benchmark_##benchname(uint64_t up_iterations); \
+    static upbench::registrar registrar_##benchname(#benchname, &benchmark_##benchname, benchiterations); \
+    static void benchmark_##benchname(uint64_t up_iterations)
+
+#define UP_BENCH_MAIN() \
+    int main() { return upbench::run(); }
+
+#endif // __CRASHLYTICS_BENCHMARK_UPBENCH_H__
@@ -22,6 +22,41 @@
 //  the purpose of being able to dynamically link with host JNI libraries.
 #define CRASHLYTICS_INCLUDE_JNI_ENTRY
 
+//! Define this to write supplementary files in the compact binary format instead of
+//  JSON text; see crashlytics/detail/binary_writer.h for the layout and
+//  tools/decode_supplementary.cpp for the offline decoder.
+//#define CRASHLYTICS_BINARY_SUPPLEMENTARY_FILES
+
+//! Define this to run a background thread that periodically snapshots the device
+//  statistics into a shared region, keeping /proc, sysfs and statfs reads out of
+//  the crash window; see crashlytics/detail/system_info_region.h.
+//#define CRASHLYTICS_SYSTEM_INFO_SAMPLER
+
+//! Define this to launch the crashpad handler process once at initialization and
+//  keep it idle on a socket, instead of spawning it from inside the dying process
+//  at crash time. Trades a few MB of resident memory for capture reliability
+//  under memory pressure, where the at-crash spawn is most likely to fail.
+//#define CRASHLYTICS_WARM_HANDLER_PROCESS
+
+//! Define this, together with CRASHLYTICS_WARM_HANDLER_PROCESS, to share one warm
+//  handler across the app's processes: the first process to initialize launches the
+//  handler and advertises its socket in the database directory, and sibling processes
+//  attach with a connect and a single descriptor transfer instead of a full spawn.
+//#define CRASHLYTICS_SHARED_HANDLER
+
+//! Define this to gzip-compress pending minidumps in the handler process after
+//  they are written, replacing X.dmp with X.dmp.gz. Large arm64 dumps shrink
+//  3-5x; CrashpadController restores X.dmp from the .gz container before the
+//  upload path looks for it.
+//#define CRASHLYTICS_COMPRESS_MINIDUMPS
+
+//! Define this to write a degraded in-process report when crashpad can't
+//  capture a crash on pre-Q devices; see handler/detail/fallback_writer.h. The
+//  report is a fixed-name JSON file in the database directory that the upload
+//  pipeline does not ingest; only enable it alongside tooling that collects
+//  the file out of band.
+//#define CRASHLYTICS_LAST_RESORT_REPORT
+
 #include <system/log.h>
 
 #if defined (CRASHLYTICS_DEBUG)
@@ -0,0 +1,282 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_BINARY_WRITER_H__
+#define __CRASHLYTICS_DETAIL_BINARY_WRITER_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#include <unistd.h>
+
+#include "crashlytics/detail/scoped_writer.h"
+#include "crashlytics/detail/syscall_io.h"
+
+//! A binary counterpart to scoped_writer, enabled with
+//  CRASHLYTICS_BINARY_SUPPLEMENTARY_FILES. Emits length-prefixed tagged records
+//  instead of JSON text, roughly halving supplementary file sizes and removing
+//  all crash-time formatting. Files are decoded off-device with
+//  tools/decode_supplementary.cpp.
+//
+//  Layout: 'CLSF' magic, a version byte, then records of
+//      tag:u8, key-length:u8, key-bytes,
+//  followed by a tag-specific payload: u64 little-endian (Uint64), a single
+//  byte (Bool), or length:u16 little-endian plus bytes (String). BeginGroup
+//  records carry a one-byte kind payload — '{' for an object, '[' for an
+//  array — so the decoder can reproduce the distinction; EndGroup records
+//  carry no payload and close the innermost group.
+
+namespace google { namespace crashlytics { namespace detail {
+
+struct binary_writer {
+    static constexpr uint8_t current_version = 2u;
+
+    enum Tag : uint8_t {
+        Uint64     = 1,
+        Bool       = 2,
+        String     = 3,
+        BeginGroup = 4,
+        EndGroup   = 5
+    };
+
+    binary_writer(int fd, Durability durability = FullSync);
+    binary_writer(const binary_writer &) = delete;
+   ~binary_writer();
+
+    struct wrapped;
+
+    void write(uint64_t value);
+    void write(const char* value);
+    void write(const char* value, std::size_t length);
+
+    //! Records are self-delimiting, so element separators are a no-op.
+    void write_separator();
+
+    //! Mirrors scoped_writer's interface; delimiters are meaningless in the
+    //  binary format and are ignored.
+    enum Delimiter {
+        Comma,
+        None,
+        NewLine
+    };
+
+    template<typename T>
+    void write(const char* key, T value, Delimiter delimiter = None);
+
+private:
+    void record(Tag tag, const char* key);
+
+    void put(uint64_t value);
+    void put(bool value);
+    void put(const char* value, std::size_t length);
+    void put(uint8_t value);
+    void put_length16(std::size_t value);
+
+    void flush();
+
+private:
+    static constexpr std::size_t buffer_capacity = 4096u;
+
+    int         fd_;
+    Durability  durability_;
+    std::size_t offset_;
+    char        buffer_[buffer_capacity];
+};
+
+}}} // namespace google::crashlytics::detail
+
+//! implementation
+
+struct google::crashlytics::detail::binary_writer::wrapped {
+    wrapped(const char* key, char open, char close, binary_writer::Delimiter delimiter, binary_writer& writer);
+    wrapped(char open, char close, binary_writer::Delimiter delimiter, binary_writer& writer);
+   ~wrapped();
+
+private:
+    binary_writer& writer_;
+};
+
+inline google::crashlytics::detail::binary_writer::binary_writer(int fd, Durability durability)
+    : fd_(fd), durability_(durability), offset_(0u)
+{
+    put(static_cast<uint8_t>('C'));
+    put(static_cast<uint8_t>('L'));
+    put(static_cast<uint8_t>('S'));
+    put(static_cast<uint8_t>('F'));
+    put(current_version);
+}
+
+inline google::crashlytics::detail::binary_writer::~binary_writer()
+{
+    flush();
+
+    switch (durability_) {
+    case FullSync:
+        if (raw::fsync(fd_) == -1) {
+            //! no-op at the moment
+        }
+        break;
+    case DataSync:
+        if (raw::fdatasync(fd_) == -1) {
+            //! no-op at the moment
+        }
+        break;
+    case NoSync:
+        break;
+    }
+
+    if (raw::close(fd_) == -1) {
+        //! no-op at the moment
+    }
+}
+
+inline void google::crashlytics::detail::binary_writer::flush()
+{
+    if (offset_ == 0u) {
+        return;
+    }
+
+    raw::write(fd_, buffer_, offset_);
+    offset_ = 0u;
+}
+
+inline void google::crashlytics::detail::binary_writer::put(uint8_t value)
+{
+    if (offset_ == buffer_capacity) {
+        flush();
+    }
+
+    buffer_[offset_++] = static_cast<char>(value);
+}
+
+inline void google::crashlytics::detail::binary_writer::put(const char* value, std::size_t length)
+{
+    while (length != 0u) {
+        if (offset_ == buffer_capacity) {
+            flush();
+        }
+
+        std::size_t chunk = std::min(length, buffer_capacity - offset_);
+
+        std::memcpy(buffer_ + offset_, value, chunk);
+
+        offset_ += chunk;
+        value   += chunk;
+        length  -= chunk;
+    }
+}
+
+inline void google::crashlytics::detail::binary_writer::put(uint64_t value)
+{
+    for (int shift = 0; shift < 64; shift += 8) {
+        put(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+inline void google::crashlytics::detail::binary_writer::put(bool value)
+{
+    put(static_cast<uint8_t>(value ? 1 : 0));
+}
+
+inline void google::crashlytics::detail::binary_writer::put_length16(std::size_t value)
+{
+    std::size_t bounded = std::min(value, static_cast<std::size_t>(UINT16_MAX));
+
+    put(static_cast<uint8_t>(bounded));
+    put(static_cast<uint8_t>(bounded >> 8));
+}
+
+inline void google::crashlytics::detail::binary_writer::record(Tag tag, const char* key)
+{
+    std::size_t length = key != nullptr ? std::strlen(key) : 0u;
+    std::size_t bounded = std::min(length, static_cast<std::size_t>(UINT8_MAX));
+
+    put(static_cast<uint8_t>(tag));
+    put(static_cast<uint8_t>(bounded));
+    put(key, bounded);
+}
+
+inline void google::crashlytics::detail::binary_writer::write(uint64_t value)
+{
+    record(Uint64, nullptr);
+    put(value);
+}
+
+inline void google::crashlytics::detail::binary_writer::write(const char* value)
+{
+    write(value, std::strlen(value));
+}
+
+inline void google::crashlytics::detail::binary_writer::write(const char* value, std::size_t length)
+{
+    record(String, nullptr);
+    put_length16(length);
+    put(value, std::min(length, static_cast<std::size_t>(UINT16_MAX)));
+}
+
+inline void google::crashlytics::detail::binary_writer::write_separator()
+{
+}
+
+namespace google { namespace crashlytics { namespace detail {
+
+template<>
+inline void binary_writer::write(const char* key, uint64_t value, Delimiter)
+{
+    record(Uint64, key);
+    put(value);
+}
+
+template<>
+inline void binary_writer::write(const char* key, bool value, Delimiter)
+{
+    record(Bool, key);
+    put(value);
+}
+
+template<>
+inline void binary_writer::write(const char* key, const char* value, Delimiter)
+{
+    std::size_t length = std::strlen(value);
+
+    record(String, key);
+    put_length16(length);
+    put(value, std::min(length, static_cast<std::size_t>(UINT16_MAX)));
+}
+
+}}} // namespace google::crashlytics::detail
+
+inline google::crashlytics::detail::binary_writer::wrapped::wrapped(const char* key, char open_char, char, binary_writer::Delimiter, binary_writer& writer)
+    : writer_(writer)
+{
+    writer_.record(BeginGroup, key);
+
+    //! The kind payload preserves the array-vs-object distinction the JSON
+    //  writer expresses through its delimiter characters.
+    writer_.put(static_cast<uint8_t>(open_char == '[' ? '[' : '{'));
+}
+
+inline google::crashlytics::detail::binary_writer::wrapped::wrapped(char open_char, char close_char, binary_writer::Delimiter delimiter, binary_writer& writer)
+    : wrapped(nullptr, open_char, close_char, delimiter, writer)
+{
+}
+
+inline google::crashlytics::detail::binary_writer::wrapped::~wrapped()
+{
+    writer_.record(EndGroup, nullptr);
+}
+
+#endif // __CRASHLYTICS_DETAIL_BINARY_WRITER_H__
@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_BREADCRUMB_REGION_H__
+#define __CRASHLYTICS_DETAIL_BREADCRUMB_REGION_H__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+//! A memory-mapped ring of breadcrumb messages shared, via a MAP_SHARED file
+//  mapping, between the app process (writer) and the crash handler process
+//  (reader). Appending is a ticket fetch-add plus two stores -- no syscalls --
+//  and the handler recovers the most recent messages in order at crash time.
+
+namespace google { namespace crashlytics { namespace detail {
+
+struct breadcrumb_region {
+    static constexpr uint32_t    magic           = 0x434c4243u; //! 'CLBC'
+    static constexpr uint32_t    current_version = 1u;
+
+    static constexpr std::size_t entry_count     = 128u;  //! Must be a power of two.
+    static constexpr std::size_t data_capacity   = 256u;
+
+    struct entry {
+        //! 2 * ticket + 1 while a write is in flight, 2 * ticket + 2 once stable.
+        std::atomic<uint32_t> sequence;
+        uint16_t              length;
+        char                  data[data_capacity];
+    };
+
+    std::atomic<uint32_t> magic_;
+    uint32_t              version_;
+    std::atomic<uint64_t> cursor_;   //! Total number of messages ever appended.
+    entry                 entries_[entry_count];
+
+    //! Appends the message, overwriting the oldest entry once the ring is full.
+    void append(const char* message, std::size_t length);
+
+    //! Invokes func(data, length) for the surviving messages, oldest first,
+    //  skipping entries that were mid-write when the process crashed.
+    template<typename Func>
+    void snapshot(Func func) const;
+
+    //! True once a writer has finished initializing the region.
+    bool valid() const;
+
+    //! Stamps a freshly-created region; the magic is published last.
+    void initialize();
+};
+
+//! Writes the surviving messages as a JSON array to the given file descriptor.
+void write_native_breadcrumbs(int fd, const breadcrumb_region& region);
+
+//! Maps the region file read-only and writes its messages to fd. Returns false
+//  if the region is missing, truncated or was never initialized.
+bool write_native_breadcrumbs_file(const char* region_path, int fd);
+
+//! The region's file name inside the crashpad database directory.
+constexpr const char* breadcrumb_region_name() { return ".native_logs"; }
+
+}}} // namespace google::crashlytics::detail
+
+//! implementation
+
+inline bool google::crashlytics::detail::breadcrumb_region::valid() const
+{
+    return magic_.load(std::memory_order_acquire) == magic && version_ == current_version;
+}
+
+inline void google::crashlytics::detail::breadcrumb_region::initialize()
+{
+    version_ = current_version;
+    magic_.store(magic, std::memory_order_release);
+}
+
+inline void google::crashlytics::detail::breadcrumb_region::append(const char* message, std::size_t length)
+{
+    uint64_t ticket = cursor_.fetch_add(1u, std::memory_order_relaxed);
+    entry&   current = entries_[ticket & (entry_count - 1)];
+
+    uint32_t busy = static_cast<uint32_t>(ticket * 2 + 1);
+    std::size_t bounded = length < data_capacity - 1 ? length : data_capacity - 1;
+
+    //! The busy transition is an acq_rel exchange, as in key_value_region: the
+    //  acquire half keeps the payload stores below from hoisting above it. A
+    //  release store only orders the other direction, which would let a reader
+    //  pass both sequence checks while copying a half-written entry.
+    current.sequence.exchange(busy, std::memory_order_acq_rel);
+
+    std::memcpy(current.data, message, bounded);
+    current.data[bounded] = '\0';
+    current.length = static_cast<uint16_t>(bounded);
+
+    current.sequence.store(busy + 1, std::memory_order_release);
+}
+
+template<typename Func>
+inline void google::crashlytics::detail::breadcrumb_region::snapshot(Func func) const
+{
+    uint64_t end   = cursor_.load(std::memory_order_acquire);
+    uint64_t begin = end > entry_count ? end - entry_count : 0u;
+
+    for (uint64_t ticket = begin; ticket < end; ++ticket) {
+        const entry& current = entries_[ticket & (entry_count - 1)];
+        uint32_t     stable = static_cast<uint32_t>(ticket * 2 + 2);
+
+        if (current.sequence.load(std::memory_order_acquire) != stable) {
+            continue;  //! Torn, or already overwritten by a newer message.
+        }
+
+        char data[data_capacity];
+        std::memcpy(data, current.data, data_capacity);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (current.sequence.load(std::memory_order_relaxed) == stable) {
+            func(data, std::strlen(data));
+        }
+    }
+}
+
+#endif // __CRASHLYTICS_DETAIL_BREADCRUMB_REGION_H__
@@ -0,0 +1,33 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_COMPRESS_H__
+#define __CRASHLYTICS_DETAIL_COMPRESS_H__
+
+namespace google { namespace crashlytics { namespace detail {
+
+//! Streams source_path through zlib into destination_path in gzip format with
+//  fixed-size buffers, so peak memory stays constant regardless of dump size.
+//  On any failure the partial destination is unlinked and false is returned,
+//  leaving the source untouched.
+bool compress_file(const char* source_path, const char* destination_path);
+
+//! Compresses every minidump in the database's pending/ directory to a
+//  .dmp.gz sibling, removing the original once the compressed copy is safely
+//  on disk. Dumps that already have a compressed sibling are skipped.
+void compress_pending_dumps(const char* database_path);
+
+}}} // namespace google::crashlytics::detail
+
+#endif // __CRASHLYTICS_DETAIL_COMPRESS_H__
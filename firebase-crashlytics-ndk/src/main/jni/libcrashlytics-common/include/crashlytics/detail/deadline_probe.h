@@ -0,0 +1,152 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_DEADLINE_PROBE_H__
+#define __CRASHLYTICS_DETAIL_DEADLINE_PROBE_H__
+
+#include <cerrno>
+#include <ctime>
+
+#include <pthread.h>
+
+#include "crashlytics/config.h"
+
+//! Filesystem probes such as statfs("/data") or a sysfs read can block
+//  indefinitely in the kernel on a wedged device; neither poll nor EINTR
+//  recovery bounds them. probe_with_deadline runs a probe on a helper thread
+//  and waits for at most a fixed budget. When the budget expires the probe is
+//  abandoned — the helper keeps the state alive and frees it whenever the
+//  kernel lets it return — and the caller falls back to a default value, which
+//  keeps total supplementary-file time bounded.
+
+namespace google { namespace crashlytics { namespace detail {
+
+//! How long a single probe may run before it is abandoned.
+constexpr unsigned int default_probe_budget_milliseconds = 500u;
+
+template<typename T, typename Func>
+struct deadline_state {
+    explicit deadline_state(Func function) : function(function), result(), finished(false), abandoned(false)
+    {
+        pthread_mutex_init(&mutex, nullptr);
+
+        pthread_condattr_t attributes;
+        pthread_condattr_init(&attributes);
+        pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+        pthread_cond_init(&condition, &attributes);
+        pthread_condattr_destroy(&attributes);
+    }
+
+   ~deadline_state()
+    {
+        pthread_cond_destroy(&condition);
+        pthread_mutex_destroy(&mutex);
+    }
+
+    Func            function;
+    T               result;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t  condition;
+    bool            finished;
+    bool            abandoned;
+};
+
+template<typename T, typename Func>
+void* probe_entry(void* opaque)
+{
+    deadline_state<T, Func>* state = static_cast<deadline_state<T, Func> *>(opaque);
+
+    T result = state->function();
+
+    pthread_mutex_lock(&state->mutex);
+    state->result = result;
+    state->finished = true;
+    bool abandoned = state->abandoned;
+    pthread_cond_signal(&state->condition);
+    pthread_mutex_unlock(&state->mutex);
+
+    //! Ownership passed to this thread when the waiter gave up.
+    if (abandoned) {
+        delete state;
+    }
+
+    return nullptr;
+}
+
+//! Runs function() on a helper thread, waiting at most budget_milliseconds.
+//  On completion within the budget, copies the probe's value into out and
+//  returns true; on expiry leaves out untouched and returns false. If no
+//  thread can be created the probe runs inline, unbounded — stale data beats
+//  none when the system is that far gone.
+template<typename T, typename Func>
+inline bool probe_with_deadline(unsigned int budget_milliseconds, T& out, Func function)
+{
+    deadline_state<T, Func>* state = new deadline_state<T, Func>(function);
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+    pthread_t thread;
+    int created = pthread_create(&thread, &attributes, probe_entry<T, Func>, state);
+
+    pthread_attr_destroy(&attributes);
+
+    if (created != 0) {
+        out = function();
+        delete state;
+        return true;
+    }
+
+    timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    deadline.tv_sec  += budget_milliseconds / 1000u;
+    deadline.tv_nsec += static_cast<long>(budget_milliseconds % 1000u) * 1000000L;
+
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    bool finished = true;
+
+    pthread_mutex_lock(&state->mutex);
+    while (!state->finished) {
+        if (pthread_cond_timedwait(&state->condition, &state->mutex, &deadline) == ETIMEDOUT && !state->finished) {
+            state->abandoned = true;
+            finished = false;
+            break;
+        }
+    }
+
+    if (finished) {
+        out = state->result;
+    }
+
+    pthread_mutex_unlock(&state->mutex);
+
+    if (finished) {
+        delete state;
+    } else {
+        DEBUG_OUT("Probe abandoned after %u ms", budget_milliseconds);
+    }
+
+    return finished;
+}
+
+}}} // namespace google::crashlytics::detail
+
+#endif // __CRASHLYTICS_DETAIL_DEADLINE_PROBE_H__
@@ -19,9 +19,21 @@
 
 namespace google { namespace crashlytics {
 
+namespace detail { struct stopwatch; }
+
 void write_device_info(int fd);
 void write_binary_libs(pid_t pid, int fd);
 
+//! As write_device_info, but prefers the sampler snapshot at region_path
+//  (see crashlytics/detail/system_info_region.h) over live /proc and sysfs
+//  reads, falling back to them when no snapshot is available.
+void write_device_info(int fd, const char* region_path);
+
+//! As above, additionally folding the handler's capture timings into the
+//  record; .device_info is the supplementary file the pipeline uploads, so
+//  the timeline rides along with it.
+void write_device_info(int fd, const char* region_path, const detail::stopwatch& timings);
+
 }} // namespace google::crashlytics
 
 #endif // __CRASHLYTICS_DEVICE_INFO_H__
@@ -23,6 +23,7 @@
 
 #include "crashlytics/config.h"
 #include "crashlytics/detail/recover_from_interrupt.h"
+#include "crashlytics/detail/syscall_io.h"
 
 namespace google { namespace crashlytics { namespace detail {
 
@@ -43,7 +44,7 @@ inline char* fgets_safe(int fd, char* storage, std::size_t storage_size, bool de
     storage_size -= 1;
 
     ssize_t bytes = RECOVER_FROM_INTERRUPT(
-            ::read(fd, reinterpret_cast<void *>(storage), storage_size)
+            raw::read(fd, reinterpret_cast<void *>(storage), storage_size)
     );
 
     if (bytes == -1) {
@@ -75,8 +76,8 @@ inline char* fgets_safe(int fd, char* storage, std::size_t storage_size, bool de
 
     //! Adjust the file's file-offset to the size of the line.
     //  Lseek is uninterruptable.
-    off_t current = ::lseek(fd, 0, SEEK_CUR);
-    off_t adjusted __attribute__((unused)) = ::lseek(fd, current - line_bound + offset, SEEK_SET);
+    off_t current = raw::lseek(fd, 0, SEEK_CUR);
+    off_t adjusted __attribute__((unused)) = raw::lseek(fd, current - line_bound + offset, SEEK_SET);
 
     return storage;
 }
@@ -85,7 +86,7 @@ template<std::size_t N>
 inline ssize_t read(int fd, char (&buffer)[N])
 {
     return RECOVER_FROM_INTERRUPT(
-            ::read(fd, reinterpret_cast<void *>(buffer), N)
+            raw::read(fd, reinterpret_cast<void *>(buffer), N)
     );
 }
 
@@ -0,0 +1,193 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_KEY_VALUE_REGION_H__
+#define __CRASHLYTICS_DETAIL_KEY_VALUE_REGION_H__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+//! A fixed-layout key/value region shared, via a MAP_SHARED file mapping, between
+//  the app process (writer) and the crash handler process (reader). The app writes
+//  custom keys with lock-free per-slot seqlocks; the handler snapshots the region
+//  into the report after the minidump is written. No JNI is involved on either side.
+
+namespace google { namespace crashlytics { namespace detail {
+
+struct key_value_region {
+    static constexpr uint32_t    magic           = 0x434c4b56u; //! 'CLKV'
+    static constexpr uint32_t    current_version = 1u;
+
+    static constexpr std::size_t slot_count      = 64u;
+    static constexpr std::size_t key_capacity    = 64u;
+    static constexpr std::size_t value_capacity  = 256u;
+
+    enum State : uint32_t {
+        Empty   = 0,   //! Slot has never been used.
+        Claimed = 1,   //! A writer is installing the key; not yet readable.
+        Used    = 2    //! Key is installed; the value is guarded by the seqlock.
+    };
+
+    struct slot {
+        std::atomic<uint32_t> state;
+        std::atomic<uint32_t> sequence;  //! Odd while a value write is in flight.
+        char                  key[key_capacity];
+        char                  value[value_capacity];
+    };
+
+    std::atomic<uint32_t> magic_;
+    uint32_t              version_;
+    slot                  slots_[slot_count];
+
+    //! Records the value for the key, claiming a free slot on first use.
+    //  Returns false if the region is out of slots or a slot is contended
+    //  beyond the retry budget; callers should then fall back to the JVM path.
+    bool set(const char* key, const char* value);
+
+    //! Invokes func(key, value) for every readable slot, taking a consistent
+    //  per-slot snapshot. Intended for the handler process at crash time.
+    template<typename Func>
+    void snapshot(Func func) const;
+
+    //! True once a writer has finished initializing the region.
+    bool valid() const;
+
+    //! Stamps a freshly-created region. The magic is published last, with a
+    //  release store, so concurrent readers never see a half-built region.
+    void initialize();
+
+private:
+    bool update(slot& current, const char* value);
+};
+
+//! Writes the readable slots as a JSON object to the given file descriptor.
+void write_native_keys(int fd, const key_value_region& region);
+
+//! Maps the region file read-only and writes its readable slots to fd.
+//  Returns false if the region is missing, truncated or was never initialized.
+bool write_native_keys_file(const char* region_path, int fd);
+
+//! The region's file name inside the crashpad database directory.
+constexpr const char* key_value_region_name() { return ".native_keys"; }
+
+}}} // namespace google::crashlytics::detail
+
+//! implementation
+
+inline bool google::crashlytics::detail::key_value_region::valid() const
+{
+    return magic_.load(std::memory_order_acquire) == magic && version_ == current_version;
+}
+
+inline void google::crashlytics::detail::key_value_region::initialize()
+{
+    version_ = current_version;
+    magic_.store(magic, std::memory_order_release);
+}
+
+inline bool google::crashlytics::detail::key_value_region::update(slot& current, const char* value)
+{
+    constexpr int retry_budget = 64;
+
+    std::size_t length = std::strlen(value);
+    std::size_t bounded = length < value_capacity - 1 ? length : value_capacity - 1;
+
+    for (int attempt = 0; attempt < retry_budget; ++attempt) {
+        uint32_t sequence = current.sequence.load(std::memory_order_relaxed);
+
+        if (sequence & 1u) {
+            continue;  //! Another writer is mid-update.
+        }
+
+        if (!current.sequence.compare_exchange_weak(sequence, sequence + 1, std::memory_order_acquire)) {
+            continue;
+        }
+
+        std::memcpy(current.value, value, bounded);
+        current.value[bounded] = '\0';
+
+        current.sequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
+
+inline bool google::crashlytics::detail::key_value_region::set(const char* key, const char* value)
+{
+    std::size_t key_length = std::strlen(key);
+
+    if (key_length >= key_capacity) {
+        return false;  //! Oversized keys take the JVM path, which truncates consistently.
+    }
+
+    for (std::size_t i = 0; i < slot_count; ++i) {
+        slot&    current = slots_[i];
+        uint32_t state = current.state.load(std::memory_order_acquire);
+
+        if (state == Used && std::strncmp(current.key, key, key_capacity) == 0) {
+            return update(current, value);
+        }
+
+        if (state == Empty) {
+            uint32_t expected = Empty;
+            if (!current.state.compare_exchange_strong(expected, Claimed, std::memory_order_acq_rel)) {
+                //! Somebody else claimed this slot first; re-examine it.
+                --i;
+                continue;
+            }
+
+            std::memcpy(current.key, key, key_length + 1);
+            current.state.store(Used, std::memory_order_release);
+
+            return update(current, value);
+        }
+    }
+
+    return false;
+}
+
+template<typename Func>
+inline void google::crashlytics::detail::key_value_region::snapshot(Func func) const
+{
+    constexpr int retry_budget = 8;
+
+    for (std::size_t i = 0; i < slot_count; ++i) {
+        const slot& current = slots_[i];
+
+        if (current.state.load(std::memory_order_acquire) != Used) {
+            continue;
+        }
+
+        char value[value_capacity];
+
+        for (int attempt = 0; attempt < retry_budget; ++attempt) {
+            uint32_t before = current.sequence.load(std::memory_order_acquire);
+            if (before & 1u) {
+                continue;
+            }
+
+            std::memcpy(value, current.value, value_capacity);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (current.sequence.load(std::memory_order_relaxed) == before) {
+                func(current.key, value);
+                break;
+            }
+        }
+    }
+}
+
+#endif // __CRASHLYTICS_DETAIL_KEY_VALUE_REGION_H__
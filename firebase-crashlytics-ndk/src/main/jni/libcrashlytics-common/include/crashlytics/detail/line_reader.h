@@ -0,0 +1,146 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_LINE_READER_H__
+#define __CRASHLYTICS_DETAIL_LINE_READER_H__
+
+#include <cstring>
+#include <unistd.h>
+
+#include <sys/types.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+#include "crashlytics/detail/syscall_io.h"
+
+namespace google { namespace crashlytics { namespace detail {
+
+//! A forward-only buffered line reader. Where fgets_safe costs a read and two lseeks per
+//  line to rewind the descriptor to the line boundary, this fills a fixed buffer with a
+//  single read and hands out lines by pointer into it, so scanning a /proc node start to
+//  finish is one syscall per buffer instead of three per line. Only usable where the
+//  descriptor is consumed in order and nothing else reads from it in between.
+
+struct line_reader {
+public:
+    explicit line_reader(int fd);
+    line_reader(const line_reader &) = delete;
+
+    //! Returns the next line with its trailing line break stripped and a terminating
+    //  character added, or nullptr once the source is drained. A line longer than the
+    //  buffer is handed out in buffer-sized fragments.
+    const char* next();
+
+    //! The length of the line most recently returned by next().
+    std::size_t length() const;
+
+private:
+    bool fill();
+
+private:
+    static constexpr std::size_t buffer_capacity = 4096u;
+
+    int         fd_;
+    std::size_t offset_;
+    std::size_t available_;
+    std::size_t length_;
+    bool        drained_;
+
+    char buffer_[buffer_capacity + 1u];
+};
+
+}}} // namespace google::crashlytics::detail
+
+//! Implementation
+
+inline google::crashlytics::detail::line_reader::line_reader(int fd)
+    : fd_(fd), offset_(0u), available_(0u), length_(0u), drained_(false)
+{
+}
+
+inline std::size_t google::crashlytics::detail::line_reader::length() const
+{
+    return length_;
+}
+
+inline bool google::crashlytics::detail::line_reader::fill()
+{
+    if (drained_) {
+        return false;
+    }
+
+    if (offset_ != 0u) {
+        std::memmove(buffer_, buffer_ + offset_, available_ - offset_);
+
+        available_ -= offset_;
+        offset_ = 0u;
+    }
+
+    if (available_ == buffer_capacity) {
+        //! A line longer than the buffer; next() hands out what is here as a fragment.
+        return false;
+    }
+
+    ssize_t bytes = RECOVER_FROM_INTERRUPT(
+            raw::read(fd_, reinterpret_cast<void *>(buffer_ + available_), buffer_capacity - available_)
+    );
+
+    if (bytes == -1) {
+        DEBUG_OUT("Failed to read from fd %d, (%d) %s", fd_, errno, strerror(errno));
+    }
+    if (bytes <= 0) {
+        drained_ = true;
+        return false;
+    }
+
+    available_ += static_cast<std::size_t>(bytes);
+    return true;
+}
+
+inline const char* google::crashlytics::detail::line_reader::next()
+{
+    for (;;) {
+        for (std::size_t i = offset_; i < available_; ++i) {
+            if (buffer_[i] == '\n') {
+                char* line = buffer_ + offset_;
+
+                length_ = i - offset_;
+                buffer_[i] = '\0';
+                offset_ = i + 1u;
+
+                return line;
+            }
+        }
+
+        if (fill()) {
+            continue;
+        }
+
+        if (offset_ == available_) {
+            return nullptr;
+        }
+
+        //! No line break in the remainder: either the last line of the source, or a
+        //  fragment of a line longer than the buffer.
+        char* line = buffer_ + offset_;
+
+        length_ = available_ - offset_;
+        buffer_[available_] = '\0';
+        offset_ = available_;
+
+        return line;
+    }
+}
+
+#endif // __CRASHLYTICS_DETAIL_LINE_READER_H__
@@ -26,6 +26,7 @@
 
 #include "crashlytics/config.h"
 #include "crashlytics/detail/recover_from_interrupt.h"
+#include "crashlytics/detail/syscall_io.h"
 #include "crashlytics/detail/lexical_cast.h"
 
 //! Provides a way to build buffers to the /proc pseudo-filesystem. Specifically,
@@ -144,7 +145,7 @@ inline google::crashlytics::detail::filesystem::managed_node_file::managed_node_
     : fd_(-1)
 {
     auto open_for_read = [](const char* filename) {
-        return RECOVER_FROM_INTERRUPT(::open(filename, O_RDONLY));
+        return RECOVER_FROM_INTERRUPT(raw::open(filename, O_RDONLY));
     };
 
     if ((fd_ = apply_to(root, pid, node, open_for_read)) == -1) {
@@ -157,7 +158,7 @@ inline google::crashlytics::detail::filesystem::managed_node_file::managed_node_
     : fd_(-1)
 {
     auto open_for_read = [](const char* filename) {
-        return RECOVER_FROM_INTERRUPT(::open(filename, O_RDONLY));
+        return RECOVER_FROM_INTERRUPT(raw::open(filename, O_RDONLY));
     };
 
     if ((fd_ = apply_to(root, pid, node, tid, subnode, open_for_read)) == -1) {
@@ -169,14 +170,14 @@ template<std::size_t M>
 inline google::crashlytics::detail::filesystem::managed_node_file::managed_node_file(const char (&path)[M])
     : fd_(-1)
 {
-    if ((fd_ = RECOVER_FROM_INTERRUPT(::open(path, O_RDONLY))) == -1) {
+    if ((fd_ = RECOVER_FROM_INTERRUPT(raw::open(path, O_RDONLY))) == -1) {
         DEBUG_OUT("::open returned -1 for %s", path);
     }
 }
 
 inline google::crashlytics::detail::filesystem::managed_node_file::~managed_node_file()
 {
-    if (fd_ != -1 && ::close(fd_) == -1) {
+    if (fd_ != -1 && raw::close(fd_) == -1) {
         DEBUG_OUT("::close returned -1 for fd %d, (%d) %s", fd_, errno, strerror(errno));
     }
 }
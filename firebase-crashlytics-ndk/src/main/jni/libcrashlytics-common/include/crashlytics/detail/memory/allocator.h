@@ -211,7 +211,8 @@ std::uint8_t* google::crashlytics::detail::memory::page_allocator<T>::allocate_p
         return nullptr;
     }
 
-    std::memset(raw, 0, size);
+    //! Fresh MAP_ANON pages are already zero-filled by the kernel; zeroing them
+    //  again here would only fault in and dirty every page up front.
     return reinterpret_cast<std::uint8_t *>(raw);
 }
 
@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_MEMORY_ARENA_H__
+#define __CRASHLYTICS_DETAIL_MEMORY_ARENA_H__
+
+#include <algorithm>
+#include <cstddef>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "crashlytics/config.h"
+
+#if defined (CRASHLYTICS_DEBUG)
+#    include <cerrno>
+#    include <cstring>
+#endif
+
+namespace google { namespace crashlytics { namespace detail { namespace memory {
+
+//! A one-shot bump arena over a single anonymous mapping. Strings that live for the
+//  duration of the process are copied into it exactly once, instead of being spread
+//  across per-string heap allocations that can never be released. In the spirit of
+//  page_allocator, the mapping is never unmapped, so the arena itself can be declared
+//  as an automatic variable; only the pointers handed out need to survive it.
+
+struct arena {
+public:
+    explicit arena(std::size_t capacity) noexcept;
+    arena(const arena &) = delete;
+
+    //! Returns size bytes from the mapping, or nullptr when the arena is exhausted
+    //  or its mapping failed.
+    char* allocate(std::size_t size);
+
+private:
+    char*       storage_;
+    std::size_t capacity_;
+    std::size_t offset_;
+};
+
+}}}} // namespace google::crashlytics::detail::memory
+
+//! Implementation
+
+inline google::crashlytics::detail::memory::arena::arena(std::size_t capacity) noexcept
+    : storage_(nullptr), capacity_(0u), offset_(0u)
+{
+    std::size_t page_size = static_cast<std::size_t>(std::max(sysconf(_SC_PAGESIZE), 1L));
+    std::size_t rounded = (capacity + page_size - 1u) / page_size * page_size;
+
+    void* raw = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+
+    if (raw == MAP_FAILED) {
+        DEBUG_OUT("mmap() failed, errno = %d (%s)", errno, strerror(errno));
+        return;
+    }
+
+    storage_ = static_cast<char *>(raw);
+    capacity_ = rounded;
+}
+
+inline char* google::crashlytics::detail::memory::arena::allocate(std::size_t size)
+{
+    if (storage_ == nullptr || capacity_ - offset_ < size) {
+        return nullptr;
+    }
+
+    char* storage = storage_ + offset_;
+
+    offset_ += size;
+    return storage;
+}
+
+#endif // __CRASHLYTICS_DETAIL_MEMORY_ARENA_H__
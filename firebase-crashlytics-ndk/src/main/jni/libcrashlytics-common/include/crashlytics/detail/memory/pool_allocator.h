@@ -0,0 +1,242 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_MEMORY_POOL_ALLOCATOR_H__
+#define __CRASHLYTICS_DETAIL_MEMORY_POOL_ALLOCATOR_H__
+
+#include <limits>
+#include <cstdint>
+#include <memory>
+#include <cstring>
+
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/memory/header.h"
+#include "crashlytics/detail/memory/allocator.h"
+
+#if defined (CRASHLYTICS_DEBUG)
+#    include <cerrno>
+#endif
+
+namespace google { namespace crashlytics { namespace detail { namespace memory {
+
+//! A size-class pool layered on the same anonymous mappings as page_allocator. Requests of up
+//  to 1KB are rounded to a power-of-two class and carved from a shared page, and freed blocks
+//  go onto a per-class freelist, so a steady allocate/deallocate churn of small objects is a
+//  single pointer pop against a handful of pages instead of one mmap per object. Blocks carry
+//  the same header marking scheme as the page allocator, with the Ignorable duration, since
+//  their backing pages are recycled through the freelists rather than unmapped. Requests
+//  larger than the biggest class fall through to page_allocator. Like the page allocator,
+//  this is meant to be declared as an automatic variable in the context of the signal handler.
+
+template<typename T>
+struct pool_allocator {
+public:
+    typedef T              value_type;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::size_t    size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<typename U>
+    struct rebind {
+        typedef pool_allocator<U> other;
+    };
+
+    pointer address(reference value);
+    const_pointer address(const_reference value) const;
+
+    pool_allocator() noexcept;
+    pool_allocator(const pool_allocator &) = delete;
+   ~pool_allocator();
+
+    template<typename U>
+    pool_allocator(const pool_allocator<U> &) = delete;
+
+    size_type max_size() noexcept;
+    pointer allocate(size_type size, const void* = 0);
+    void deallocate(pointer p, size_type size);
+
+    void construct(pointer p, const_reference value);
+    void destroy(pointer p);
+
+private:
+    void*         allocate_block(std::size_t index);
+    std::uint8_t* allocate_carve_page();
+
+private:
+    static constexpr std::size_t class_count = 7u;
+
+    std::uint8_t* free_[class_count];
+    std::uint8_t* carve_page_;
+
+    std::size_t page_size_;
+    std::size_t carve_offset_;
+
+    page_allocator<T> overflow_;
+};
+
+}}}} // namespace google::crashlytics::detail::memory
+
+//! Implementation
+
+namespace google { namespace crashlytics { namespace detail { namespace memory { namespace detail {
+
+constexpr std::size_t minimum_class_size = 16u;
+constexpr std::size_t maximum_class_size = 1024u;
+
+//! The index of the smallest class that fits size; sizes are clamped below by the minimum
+//  class, which leaves every block with enough room to double as a freelist node.
+inline std::size_t class_index_for_size(std::size_t size)
+{
+    std::size_t index = 0;
+
+    for (std::size_t class_size = minimum_class_size; class_size < size; class_size <<= 1) {
+        ++index;
+    }
+
+    return index;
+}
+
+inline std::size_t class_size_for_index(std::size_t index)
+{
+    return minimum_class_size << index;
+}
+
+}}}}}
+
+template<typename T>
+auto google::crashlytics::detail::memory::pool_allocator<T>::address(reference value) -> pointer
+{
+    return &value;
+}
+
+template<typename T>
+auto google::crashlytics::detail::memory::pool_allocator<T>::address(const_reference value) const -> const_pointer
+{
+    return &value;
+}
+
+template<typename T>
+google::crashlytics::detail::memory::pool_allocator<T>::pool_allocator() noexcept
+    : carve_page_(nullptr), page_size_(std::max(sysconf(_SC_PAGESIZE), 0L)), carve_offset_(0u)
+{
+    std::memset(free_, 0, sizeof free_);
+}
+
+template<typename T>
+google::crashlytics::detail::memory::pool_allocator<T>::~pool_allocator()
+{
+}
+
+template<typename T>
+auto google::crashlytics::detail::memory::pool_allocator<T>::max_size() noexcept -> size_type
+{
+    return overflow_.max_size();
+}
+
+template<typename T>
+auto google::crashlytics::detail::memory::pool_allocator<T>::allocate(size_type size, const void *) -> pointer
+{
+    if (size == 0u) {
+        return nullptr;
+    }
+
+    std::size_t bytes = size * sizeof (T);
+
+    if (bytes > detail::maximum_class_size) {
+        return overflow_.allocate(size);
+    }
+
+    return static_cast<pointer>(allocate_block(detail::class_index_for_size(bytes)));
+}
+
+template<typename T>
+void google::crashlytics::detail::memory::pool_allocator<T>::deallocate(pointer p, size_type size)
+{
+    //! As in allocate, size is an element count; routing and class selection use
+    //  the same byte total, so a block always returns to the freelist it came from.
+    std::size_t bytes = size * sizeof (T);
+
+    if (bytes > detail::maximum_class_size) {
+        overflow_.deallocate(p, bytes);
+        return;
+    }
+
+    if (detail::duration(p) != detail::Ignorable) {
+        //! Deallocate only blocks that this pool carved; a static fallback stays put.
+        return;
+    }
+
+    std::size_t   index = detail::class_index_for_size(bytes);
+    std::uint8_t* storage = reinterpret_cast<std::uint8_t *>(p);
+
+    std::memcpy(storage, &free_[index], sizeof free_[index]);
+    free_[index] = storage;
+}
+
+template<typename T>
+void google::crashlytics::detail::memory::pool_allocator<T>::construct(pointer p, const_reference value)
+{
+    new (p) T(value);
+}
+
+template<typename T>
+void google::crashlytics::detail::memory::pool_allocator<T>::destroy(pointer p)
+{
+    p->~T();
+}
+
+template<typename T>
+void* google::crashlytics::detail::memory::pool_allocator<T>::allocate_block(std::size_t index)
+{
+    if (std::uint8_t* storage = free_[index]) {
+        std::memcpy(&free_[index], storage, sizeof free_[index]);
+        return storage;
+    }
+
+    std::size_t required = detail::class_size_for_index(index) + sizeof (detail::header);
+
+    if (carve_page_ == nullptr || page_size_ - carve_offset_ < required) {
+        if ((carve_page_ = allocate_carve_page()) == nullptr) {
+            return nullptr;
+        }
+
+        carve_offset_ = 0u;
+    }
+
+    std::uint8_t* storage = carve_page_ + carve_offset_;
+
+    carve_offset_ += required;
+    return detail::mark(storage, detail::Ignorable);
+}
+
+template<typename T>
+std::uint8_t* google::crashlytics::detail::memory::pool_allocator<T>::allocate_carve_page()
+{
+    void* raw = mmap(NULL, page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+
+    if (raw == MAP_FAILED) {
+        DEBUG_OUT("mmap() failed, errno = %d (%s)", errno, strerror(errno));
+        return nullptr;
+    }
+
+    return reinterpret_cast<std::uint8_t *>(raw);
+}
+
+#endif // __CRASHLYTICS_DETAIL_MEMORY_POOL_ALLOCATOR_H__
@@ -0,0 +1,72 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_STOPWATCH_H__
+#define __CRASHLYTICS_DETAIL_STOPWATCH_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <ctime>
+
+#include "crashlytics/detail/supplementary_file.h"
+
+//! A fixed-capacity stopwatch for the crash handler: CLOCK_MONOTONIC reads into
+//  a preallocated array, folded afterwards into the .device_info supplementary
+//  record the pipeline uploads. Gives field visibility into where capture time
+//  goes, stage by stage.
+
+namespace google { namespace crashlytics { namespace detail {
+
+struct stopwatch {
+    static constexpr std::size_t mark_capacity = 16u;
+
+    struct mark_entry {
+        const char* name;  //! Expected to be a string literal.
+        uint64_t    nanoseconds;
+    };
+
+    stopwatch() : count_(0u) {}
+
+    //! Records a named instant; a no-op once the preallocated slots are full.
+    void mark(const char* name)
+    {
+        if (count_ == mark_capacity) {
+            return;
+        }
+
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        marks_[count_++] = {
+                name,
+                static_cast<uint64_t>(now.tv_sec) * 1000000000u + static_cast<uint64_t>(now.tv_nsec)
+        };
+    }
+
+    std::size_t       count() const              { return count_; }
+    const mark_entry& at(std::size_t index) const { return marks_[index]; }
+
+private:
+    std::size_t count_;
+    mark_entry  marks_[mark_capacity];
+};
+
+//! Writes each mark as its microsecond offset from the first, in order, as a
+//  "capture_timings" group within the caller's record, so it reads as a
+//  cumulative timeline of the handler's stages.
+void write_timings(supplementary_writer& writer, const stopwatch& timings);
+
+}}} // namespace google::crashlytics::detail
+
+#endif // __CRASHLYTICS_DETAIL_STOPWATCH_H__
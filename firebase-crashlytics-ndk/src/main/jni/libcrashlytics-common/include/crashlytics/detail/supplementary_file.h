@@ -17,13 +17,27 @@
 
 #include <cstring>
 #include <cerrno>
+#include <iterator>
 
 #include "crashlytics/config.h"
 #include "crashlytics/detail/scoped_writer.h"
 #include "crashlytics/detail/device_info.h"
 
+#if defined (CRASHLYTICS_BINARY_SUPPLEMENTARY_FILES)
+#    include "crashlytics/detail/binary_writer.h"
+#endif
+
 namespace google { namespace crashlytics { namespace detail {
 
+//! The writer supplementary files are produced with; either JSON text or, when
+//  CRASHLYTICS_BINARY_SUPPLEMENTARY_FILES is defined, the compact binary format
+//  decoded off-device with tools/decode_supplementary.cpp.
+#if defined (CRASHLYTICS_BINARY_SUPPLEMENTARY_FILES)
+using supplementary_writer = binary_writer;
+#else
+using supplementary_writer = scoped_writer;
+#endif
+
 template<std::size_t N>
 inline void make_suppliment_path_from(const char* path, const char* suffix, char (&buffer)[N])
 {
@@ -0,0 +1,91 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_SYSCALL_IO_H__
+#define __CRASHLYTICS_DETAIL_SYSCALL_IO_H__
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+//! Raw-syscall I/O for the crash-window code paths. The libc write/open/read entry
+//  points are a popular interposition target for hooking and security frameworks, and
+//  an unsafe interposer inside the signal handler means a crash inside the crash
+//  handler. Entering the kernel through syscall(2) with the per-ABI __NR numbers
+//  bypasses those hooks (and the PLT indirection) entirely; the wrappers keep the
+//  libc signatures so call sites read the same. Everything here is async-signal-safe
+//  by construction. openat is used instead of open, which doesn't exist on arm64.
+
+namespace google { namespace crashlytics { namespace detail { namespace raw {
+
+inline int open(const char* filename, int flags) __attribute__((always_inline));
+inline int open(const char* filename, int flags)
+{
+    return static_cast<int>(::syscall(__NR_openat, AT_FDCWD, filename, flags, 0));
+}
+
+inline int open(const char* filename, int flags, mode_t mode) __attribute__((always_inline));
+inline int open(const char* filename, int flags, mode_t mode)
+{
+    return static_cast<int>(::syscall(__NR_openat, AT_FDCWD, filename, flags, mode));
+}
+
+inline ssize_t read(int fd, void* buffer, std::size_t size) __attribute__((always_inline));
+inline ssize_t read(int fd, void* buffer, std::size_t size)
+{
+    return ::syscall(__NR_read, fd, buffer, size);
+}
+
+inline ssize_t write(int fd, const void* buffer, std::size_t size) __attribute__((always_inline));
+inline ssize_t write(int fd, const void* buffer, std::size_t size)
+{
+    return ::syscall(__NR_write, fd, buffer, size);
+}
+
+inline ssize_t writev(int fd, const struct iovec* vectors, int count) __attribute__((always_inline));
+inline ssize_t writev(int fd, const struct iovec* vectors, int count)
+{
+    return ::syscall(__NR_writev, fd, vectors, count);
+}
+
+inline off_t lseek(int fd, off_t offset, int whence) __attribute__((always_inline));
+inline off_t lseek(int fd, off_t offset, int whence)
+{
+    return static_cast<off_t>(::syscall(__NR_lseek, fd, offset, whence));
+}
+
+inline int close(int fd) __attribute__((always_inline));
+inline int close(int fd)
+{
+    return static_cast<int>(::syscall(__NR_close, fd));
+}
+
+inline int fsync(int fd) __attribute__((always_inline));
+inline int fsync(int fd)
+{
+    return static_cast<int>(::syscall(__NR_fsync, fd));
+}
+
+inline int fdatasync(int fd) __attribute__((always_inline));
+inline int fdatasync(int fd)
+{
+    return static_cast<int>(::syscall(__NR_fdatasync, fd));
+}
+
+}}}} // namespace google::crashlytics::detail::raw
+
+#endif // __CRASHLYTICS_DETAIL_SYSCALL_IO_H__
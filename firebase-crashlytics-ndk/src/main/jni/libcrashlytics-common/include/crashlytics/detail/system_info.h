@@ -22,7 +22,8 @@
 #include <sys/statfs.h>
 
 #include "crashlytics/config.h"
-#include "crashlytics/detail/fgets_safe.h"
+#include "crashlytics/detail/deadline_probe.h"
+#include "crashlytics/detail/line_reader.h"
 #include "crashlytics/detail/managed_node_open.h"
 #include "crashlytics/detail/lexical_cast.h"
 
@@ -40,9 +41,10 @@ inline std::size_t extract(const char* entry, T& n)
 inline std::size_t read_battery_capacity(int fd)
 {
     //! The capacity file shows values between 0 and 100.
-    char capacity_string[4] = {};
+    line_reader reader(fd);
+    const char* capacity_string = reader.next();
 
-    if (fgets_safe(fd, capacity_string, sizeof capacity_string, false) == nullptr) {
+    if (capacity_string == nullptr) {
         DEBUG_OUT("Couldn't read the battery capacity");
         return 0u;
     }
@@ -72,27 +74,33 @@ inline uint64_t parse_kb_value(const char* str, std::size_t length)
 }
 
 template<std::size_t N>
-inline uint64_t read_memory_statistics_from_proc_fragment(int fd, const char (&what)[N])
+inline uint64_t parse_proc_fragment(const char* buffer, std::size_t buffer_size, const char (&what)[N])
 {
-    char  buffer[256] = { 0 };
-    char* p = nullptr;
-
-    while ((p = fgets_safe(fd, buffer, sizeof buffer, false)) != nullptr &&
-            strncmp(buffer, what, N - 1) != 0) {
-    }
-
-    lseek(fd, 0, SEEK_SET);
-
-    return p == nullptr ? static_cast<uint64_t>(0) : parse_kb_value(
+    return buffer_size > N && std::strncmp(buffer, what, N - 1) == 0 ? parse_kb_value(
             buffer + N,
-            sizeof buffer - 1 - N
-    );
+            buffer_size - 1 - N
+    ) : static_cast<uint64_t>(0);
 }
 
 inline std::pair<uint64_t, uint64_t> memory_statistics_from_proc(int fd)
 {
-    uint64_t total = read_memory_statistics_from_proc_fragment(fd, "MemTotal:");
-    uint64_t free  = read_memory_statistics_from_proc_fragment(fd, "MemFree:");
+    line_reader reader(fd);
+
+    uint64_t total = 0;
+    uint64_t free  = 0;
+
+    //! Both fragments are collected in a single buffered pass over the node; a typical
+    //  /proc/meminfo fits in the reader's buffer, so the whole scan is one read().
+    while (total == 0 || free == 0) {
+        const char* line = reader.next();
+
+        if (line == nullptr) {
+            break;
+        }
+
+        if (total == 0) { total = parse_proc_fragment(line, reader.length() + 1, "MemTotal:"); }
+        if (free  == 0) { free  = parse_proc_fragment(line, reader.length() + 1, "MemFree:"); }
+    }
 
     //! Convert to bytes if present.
     return total == 0 || free == 0 ? memory_statistics_from_sysconf() : std::make_pair(
@@ -101,15 +109,13 @@ inline std::pair<uint64_t, uint64_t> memory_statistics_from_proc(int fd)
     );
 }
 
-//! Returns { total-physical-memory, available-physical-memory }
-inline std::pair<uint64_t, uint64_t> memory_statistics()
+inline std::pair<uint64_t, uint64_t> memory_statistics_now()
 {
     filesystem::managed_node_file managed("/proc/meminfo");
     return managed ? memory_statistics_from_proc(managed.fd()) : memory_statistics_from_sysconf();
 }
 
-//! Returns { total-internal-storage, available-internal-storage }
-inline std::pair<uint64_t, uint64_t> internal_storage_statistics()
+inline std::pair<uint64_t, uint64_t> internal_storage_statistics_now()
 {
     struct statfs vfs;
     return RECOVER_FROM_INTERRUPT(statfs("/data", &vfs)) == 0 ? std::make_pair(
@@ -121,14 +127,48 @@ inline std::pair<uint64_t, uint64_t> internal_storage_statistics()
     );
 }
 
-//! Return % battery remaining
-inline std::size_t battery_capacity()
+inline std::size_t battery_capacity_now()
 {
     //! Note, this path isn't the same for emulators.
     filesystem::managed_node_file managed("/sys/class/power_supply/battery/capacity");
     return managed ? read_battery_capacity(managed.fd()) : 0u;
 }
 
+//! The *_now collectors above touch /proc, /data and sysfs directly, any of
+//  which can wedge; the public collectors below run them under a deadline so a
+//  stuck probe costs a bounded amount of crash-handling time and yields the
+//  same values a failed probe would.
+
+//! Returns { total-physical-memory, available-physical-memory }
+inline std::pair<uint64_t, uint64_t> memory_statistics()
+{
+    std::pair<uint64_t, uint64_t> statistics { 0, 0 };
+
+    if (!probe_with_deadline(default_probe_budget_milliseconds, statistics, [] { return memory_statistics_now(); })) {
+        return memory_statistics_from_sysconf();
+    }
+
+    return statistics;
+}
+
+//! Returns { total-internal-storage, available-internal-storage }
+inline std::pair<uint64_t, uint64_t> internal_storage_statistics()
+{
+    std::pair<uint64_t, uint64_t> statistics { 0, 0 };
+    probe_with_deadline(default_probe_budget_milliseconds, statistics, [] { return internal_storage_statistics_now(); });
+
+    return statistics;
+}
+
+//! Return % battery remaining
+inline std::size_t battery_capacity()
+{
+    std::size_t capacity = 0;
+    probe_with_deadline(default_probe_budget_milliseconds, capacity, [] { return battery_capacity_now(); });
+
+    return capacity;
+}
+
 }}} // namespace google::crashlytics::detail
 
 #endif // __CRASHLYTICS_DETAIL_SYSTEM_INFO_H__
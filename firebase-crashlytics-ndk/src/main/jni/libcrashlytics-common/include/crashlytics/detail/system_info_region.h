@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_SYSTEM_INFO_REGION_H__
+#define __CRASHLYTICS_DETAIL_SYSTEM_INFO_REGION_H__
+
+#include <atomic>
+#include <cstdint>
+
+//! A double-buffered snapshot of the device statistics that go into the
+//  .device_info supplementary file, shared via a MAP_SHARED file mapping between
+//  the app process and the crash handler process. A sampler thread in the app
+//  refreshes the inactive buffer and flips it live under a seqlock, so at crash
+//  time the handler copies a consistent sample instead of touching /proc, sysfs
+//  and statfs inside the crash window.
+
+namespace google { namespace crashlytics { namespace detail {
+
+struct system_info_region {
+    static constexpr uint32_t magic           = 0x434c5349u; //! 'CLSI'
+    static constexpr uint32_t current_version = 1u;
+
+    struct sample {
+        uint64_t total_physical_memory;
+        uint64_t available_physical_memory;
+        uint64_t total_internal_storage;
+        uint64_t available_internal_storage;
+        uint64_t battery;
+    };
+
+    struct buffer {
+        std::atomic<uint32_t> sequence;  //! Odd while a publish is in flight; zero until first publish.
+        sample                value;
+    };
+
+    std::atomic<uint32_t> magic_;
+    uint32_t              version_;
+    std::atomic<uint32_t> latest_;
+    buffer                buffers_[2];
+
+    //! Publishes a fresh sample into the inactive buffer and flips it live.
+    //  There is a single writer, the sampler thread; readers never block it.
+    void publish(const sample& value);
+
+    //! Copies the most recently published sample. Returns false if nothing has
+    //  been published yet or the read stayed torn beyond the retry budget, in
+    //  which case callers should collect the statistics live.
+    bool read_latest(sample& out) const;
+
+    //! True once a writer has finished initializing the region.
+    bool valid() const;
+
+    //! Stamps a freshly-created region. The magic is published last, with a
+    //  release store, so concurrent readers never see a half-built region.
+    void initialize();
+};
+
+//! The region's file name inside the crashpad database directory.
+constexpr const char* system_info_region_name() { return ".system_info"; }
+
+}}} // namespace google::crashlytics::detail
+
+//! implementation
+
+inline bool google::crashlytics::detail::system_info_region::valid() const
+{
+    return magic_.load(std::memory_order_acquire) == magic && version_ == current_version;
+}
+
+inline void google::crashlytics::detail::system_info_region::initialize()
+{
+    version_ = current_version;
+    magic_.store(magic, std::memory_order_release);
+}
+
+inline void google::crashlytics::detail::system_info_region::publish(const sample& value)
+{
+    uint32_t next = latest_.load(std::memory_order_relaxed) ^ 1u;
+    buffer&  inactive = buffers_[next];
+
+    uint32_t sequence = inactive.sequence.load(std::memory_order_relaxed);
+
+    inactive.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    inactive.value = value;
+
+    inactive.sequence.store(sequence + 2, std::memory_order_release);
+    latest_.store(next, std::memory_order_release);
+}
+
+inline bool google::crashlytics::detail::system_info_region::read_latest(sample& out) const
+{
+    constexpr int retry_budget = 8;
+
+    for (int attempt = 0; attempt < retry_budget; ++attempt) {
+        const buffer& latest = buffers_[latest_.load(std::memory_order_acquire) & 1u];
+
+        uint32_t before = latest.sequence.load(std::memory_order_acquire);
+        if (before == 0 || (before & 1u)) {
+            continue;  //! Never published, or the writer is mid-flip.
+        }
+
+        out = latest.value;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (latest.sequence.load(std::memory_order_relaxed) == before) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif // __CRASHLYTICS_DETAIL_SYSTEM_INFO_REGION_H__
@@ -0,0 +1,40 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_DETAIL_TRACE_H__
+#define __CRASHLYTICS_DETAIL_TRACE_H__
+
+//! Thin wrapper over the NDK's ATrace_beginSection/ATrace_endSection so the
+//  initialization path decomposes in systrace/Perfetto captures. The symbols
+//  entered the NDK at API 23 and are resolved dynamically, keeping the library
+//  loadable on older devices, where the spans are simply absent.
+
+namespace google { namespace crashlytics { namespace detail {
+
+struct trace {
+    static void begin(const char* name);
+    static void end();
+};
+
+//! A scoped trace span; sections nest like scopes do.
+struct scoped_trace {
+    explicit scoped_trace(const char* name) { trace::begin(name); }
+   ~scoped_trace()                          { trace::end(); }
+
+    scoped_trace(const scoped_trace &) = delete;
+};
+
+}}} // namespace google::crashlytics::detail
+
+#endif // __CRASHLYTICS_DETAIL_TRACE_H__
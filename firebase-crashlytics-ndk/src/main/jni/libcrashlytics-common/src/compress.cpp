@@ -0,0 +1,173 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <zlib.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/scoped_writer.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+
+#include "crashlytics/detail/compress.h"
+
+namespace google { namespace crashlytics { namespace detail {
+namespace {
+
+constexpr std::size_t chunk_capacity = 16u * 1024u;
+
+//! 15 window bits plus 16 selects the gzip container, so standard tooling and
+//  the upload path can decompress without custom framing.
+constexpr int gzip_window_bits = 15 + 16;
+
+bool write_fully(int fd, const unsigned char* data, std::size_t length)
+{
+    while (length != 0u) {
+        ssize_t written = RECOVER_FROM_INTERRUPT(::write(fd, data, length));
+
+        if (written <= 0) {
+            return false;
+        }
+
+        data   += written;
+        length -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+}
+
+bool deflate_stream(int source_fd, int destination_fd)
+{
+    z_stream stream;
+    std::memset(&stream, 0, sizeof stream);
+
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, gzip_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    unsigned char input[chunk_capacity];
+    unsigned char output[chunk_capacity];
+
+    int flush = Z_NO_FLUSH;
+    bool ok = true;
+
+    do {
+        ssize_t bytes = RECOVER_FROM_INTERRUPT(::read(source_fd, input, sizeof input));
+
+        if (bytes < 0) {
+            ok = false;
+            break;
+        }
+
+        flush = bytes == 0 ? Z_FINISH : Z_NO_FLUSH;
+
+        stream.next_in  = input;
+        stream.avail_in = static_cast<uInt>(bytes);
+
+        do {
+            stream.next_out  = output;
+            stream.avail_out = sizeof output;
+
+            if (deflate(&stream, flush) == Z_STREAM_ERROR) {
+                ok = false;
+                break;
+            }
+
+            if (!write_fully(destination_fd, output, sizeof output - stream.avail_out)) {
+                ok = false;
+                break;
+            }
+        } while (stream.avail_out == 0);
+    } while (ok && flush != Z_FINISH);
+
+    deflateEnd(&stream);
+    return ok;
+}
+
+} // anonymous namespace
+}}}
+
+bool google::crashlytics::detail::compress_file(const char* source_path, const char* destination_path)
+{
+    int source_fd;
+    if ((source_fd = RECOVER_FROM_INTERRUPT(::open(source_path, O_RDONLY))) == -1) {
+        DEBUG_OUT("Couldn't open '%s' for compression; %s", source_path, strerror(errno));
+        return false;
+    }
+
+    int destination_fd;
+    if ((destination_fd = google::crashlytics::detail::open(destination_path)) == -1) {
+        DEBUG_OUT("Couldn't open '%s'; %s", destination_path, strerror(errno));
+        ::close(source_fd);
+        return false;
+    }
+
+    bool ok = deflate_stream(source_fd, destination_fd);
+
+    if (ok && ::fsync(destination_fd) == -1) {
+        ok = false;
+    }
+
+    ::close(source_fd);
+    ::close(destination_fd);
+
+    if (!ok) {
+        DEBUG_OUT("Compression of '%s' failed; keeping the original", source_path);
+        ::unlink(destination_path);
+    }
+
+    return ok;
+}
+
+void google::crashlytics::detail::compress_pending_dumps(const char* database_path)
+{
+    std::string pending = std::string(database_path) + "/pending";
+
+    DIR* handle = ::opendir(pending.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+
+    while (struct dirent* node = ::readdir(handle)) {
+        std::size_t length = std::strlen(node->d_name);
+
+        if (length < 4u || std::strcmp(node->d_name + length - 4u, ".dmp") != 0) {
+            continue;
+        }
+
+        std::string source = pending + "/" + node->d_name;
+        std::string destination = source + ".gz";
+
+        struct stat status;
+        if (::stat(destination.c_str(), &status) == 0) {
+            continue;  //! Already compressed on an earlier pass.
+        }
+
+        if (compress_file(source.c_str(), destination.c_str())) {
+            DEBUG_OUT("Compressed '%s'", source.c_str());
+            ::unlink(source.c_str());
+        }
+    }
+
+    ::closedir(handle);
+}
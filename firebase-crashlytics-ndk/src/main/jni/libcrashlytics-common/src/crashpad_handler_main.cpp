@@ -16,22 +16,75 @@
 
 #include "handler/handler_main.h"
 #include "crashlytics/detail/supplementary_file.h"
+#include "crashlytics/detail/system_info_region.h"
+#include "crashlytics/detail/key_value_region.h"
+#include "crashlytics/detail/breadcrumb_region.h"
+#include "crashlytics/detail/stopwatch.h"
+
+#if defined (CRASHLYTICS_COMPRESS_MINIDUMPS)
+#    include "crashlytics/detail/compress.h"
+#endif
 
 extern "C"
 int CrashpadHandlerMain(int argc, char* argv[])
 {
+    //! Stage timings for the whole capture, folded into .device_info — the
+    //  supplementary file the pipeline actually uploads — so we can track
+    //  capture-latency regressions through the normal ingest pipeline.
+    google::crashlytics::detail::stopwatch timings;
+    timings.mark("handler_entry");
+
     int status = crashpad::HandlerMain(argc, argv, nullptr);
 
+    timings.mark("dump_written");
+
     std::string path_spec { argv[1] };
-    std::string path {
-        path_spec.substr(path_spec.find('=') + 1, path_spec.length()) + "/supp.files" };
+    std::string database { path_spec.substr(path_spec.find('=') + 1, path_spec.length()) };
+    std::string path { database + "/supp.files" };
 
     DEBUG_OUT("Writing supplementary files to %s", path.c_str());
 
-    google::crashlytics::detail::write_supplimentary_file(path.c_str(), ".device_info", [](int fd) {
-        google::crashlytics::write_device_info(fd);
+    //! Custom keys recorded through the shared-memory store, written by the app
+    //  process with no JVM involvement; see crashlytics/detail/key_value_region.h.
+    std::string region_path { database + "/" + google::crashlytics::detail::key_value_region_name() };
+
+    google::crashlytics::detail::write_supplimentary_file(path.c_str(), ".keys", [&](int fd) {
+        google::crashlytics::detail::write_native_keys_file(region_path.c_str(), fd);
+    });
+
+    timings.mark("keys_written");
+
+    //! Breadcrumbs appended to the memory-mapped ring; see
+    //  crashlytics/detail/breadcrumb_region.h.
+    std::string breadcrumb_path { database + "/" + google::crashlytics::detail::breadcrumb_region_name() };
+
+    google::crashlytics::detail::write_supplimentary_file(path.c_str(), ".logs", [&](int fd) {
+        google::crashlytics::detail::write_native_breadcrumbs_file(breadcrumb_path.c_str(), fd);
     });
 
+    timings.mark("logs_written");
+
+#if defined (CRASHLYTICS_COMPRESS_MINIDUMPS)
+    //! Dump bytes hit the disk once more here, but compressed; the original is
+    //  only removed after the .gz copy is synced.
+    google::crashlytics::detail::compress_pending_dumps(database.c_str());
+
+    timings.mark("dump_compressed");
+#endif
+
+    //! Device statistics come from the sampler snapshot when the app process
+    //  maintains one; see crashlytics/detail/system_info_region.h. Written last,
+    //  with the capture timings folded in, so the timeline covers every stage.
+    std::string system_info_path { database + "/" + google::crashlytics::detail::system_info_region_name() };
+
+    google::crashlytics::detail::write_supplimentary_file(path.c_str(), ".device_info", [&](int fd) {
+        google::crashlytics::write_device_info(fd, system_info_path.c_str(), timings);
+    });
+
+    //! The supplementary writers all defer durability; one directory sync makes the
+    //  whole batch durable instead of paying a journal flush per file.
+    google::crashlytics::detail::sync_directory(database.c_str());
+
     DEBUG_OUT("Done");
 
     return status;
@@ -17,64 +17,45 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 
 #include "crashlytics/config.h"
 #include "crashlytics/detail/scoped_writer.h"
-#include "crashlytics/detail/lexical_cast.h"
+#include "crashlytics/detail/format.h"
+#include "crashlytics/detail/syscall_io.h"
 
-void google::crashlytics::detail::impl::write(int fd, char value)
-{
-    ::write(fd, &value, sizeof (char));
-}
-
-void google::crashlytics::detail::impl::write(int fd, uint64_t value)
-{
-    char buffer[20] = { 0 };
-    std::size_t length = crashlytics::detail::lexical_cast(value, buffer);
-
-    ::write(fd, buffer, length);
-}
-
-void google::crashlytics::detail::impl::write(int fd, bool value)
+int google::crashlytics::detail::open(const char* filename)
 {
-    impl::write_sequence(fd, value ? "true" : "false");
+    return raw::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
 }
 
-void google::crashlytics::detail::impl::write(int fd, const char* value)
+void google::crashlytics::detail::sync_directory(const char* path)
 {
-    std::size_t length = std::strlen(value);
-
-    ::write(fd, "\"", sizeof (char));
-    ::write(fd, value, std::max(value[length - 1] == '\n' ? length - 1 : length, static_cast<std::size_t>(0)));
-    ::write(fd, "\"", sizeof (char));
-}
+    int fd = raw::open(path, O_RDONLY | O_DIRECTORY);
 
-void google::crashlytics::detail::impl::write(int fd, const char* value, std::size_t length)
-{
-    ::write(fd, value, length);
-}
+    if (fd == -1) {
+        DEBUG_OUT("Couldn't open directory '%s' for syncing", path);
+        return;
+    }
 
-void google::crashlytics::detail::impl::write_sequence(int fd, const char* value)
-{
-    ::write(fd, value, std::strlen(value));
-}
+    if (raw::fsync(fd) == -1) {
+        DEBUG_OUT("Couldn't sync directory '%s'", path);
+    }
 
-int google::crashlytics::detail::open(const char* filename)
-{
-    return ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    raw::close(fd);
 }
 
 google::crashlytics::detail::scoped_writer::wrapped::wrapped(const char* key, char open_char, char close_char, scoped_writer::Delimiter delimiter, scoped_writer& writer)
     : key_(key), close_(close_char), delimiter_(delimiter), writer_(writer)
 {
     if (key != nullptr) {
-        impl::write(writer.fd_, key_);
-        impl::write(writer.fd_, ':');
+        writer_.put(key_);
+        writer_.put(':');
     }
 
-    impl::write(writer.fd_, open_char);
+    writer_.put(open_char);
 }
 
 google::crashlytics::detail::scoped_writer::wrapped::wrapped(char open_char, char close_char, scoped_writer::Delimiter delimiter, scoped_writer& writer)
@@ -84,45 +65,141 @@ google::crashlytics::detail::scoped_writer::wrapped::wrapped(char open_char, cha
 
 google::crashlytics::detail::scoped_writer::wrapped::~wrapped()
 {
-    impl::write(writer_.fd_, close_);
+    writer_.put(close_);
 
     switch (delimiter_) {
     case scoped_writer::Comma:
-        impl::write(writer_.fd_, ',');
+        writer_.put(',');
         break;
     case scoped_writer::NewLine:
-        impl::write(writer_.fd_, '\n');
+        writer_.put('\n');
         break;
     case scoped_writer::None:
         break;
     }
 }
 
-google::crashlytics::detail::scoped_writer::scoped_writer(int fd) : fd_(fd)
+google::crashlytics::detail::scoped_writer::scoped_writer(int fd, Durability durability)
+    : fd_(fd), durability_(durability), offset_(0u)
 {
 }
 
 google::crashlytics::detail::scoped_writer::~scoped_writer()
 {
-    if (::fsync(fd_) == -1) {
-        //! no-op at the moment
+    flush();
+
+    switch (durability_) {
+    case FullSync:
+        if (crashlytics::detail::raw::fsync(fd_) == -1) {
+            //! no-op at the moment
+        }
+        break;
+    case DataSync:
+        if (crashlytics::detail::raw::fdatasync(fd_) == -1) {
+            //! no-op at the moment
+        }
+        break;
+    case NoSync:
+        break;
     }
-    if (::close(fd_) == -1) {
+
+    if (crashlytics::detail::raw::close(fd_) == -1) {
         //! no-op at the moment
     }
 }
 
+void google::crashlytics::detail::scoped_writer::flush()
+{
+    if (offset_ == 0u) {
+        return;
+    }
+
+    crashlytics::detail::raw::write(fd_, buffer_, offset_);
+    offset_ = 0u;
+}
+
+void google::crashlytics::detail::scoped_writer::put(char value)
+{
+    if (offset_ == buffer_capacity) {
+        flush();
+    }
+
+    buffer_[offset_++] = value;
+}
+
+void google::crashlytics::detail::scoped_writer::put(uint64_t value)
+{
+    char buffer[crashlytics::detail::maximum_decimal_length];
+    std::size_t length = crashlytics::detail::format_to(buffer, value);
+
+    put(buffer, length);
+}
+
+void google::crashlytics::detail::scoped_writer::put(bool value)
+{
+    const char* sequence = value ? "true" : "false";
+    put(sequence, std::strlen(sequence));
+}
+
+void google::crashlytics::detail::scoped_writer::put(const char* value)
+{
+    std::size_t length = std::strlen(value);
+
+    put('"');
+    put(value, std::max(value[length - 1] == '\n' ? length - 1 : length, static_cast<std::size_t>(0)));
+    put('"');
+}
+
+void google::crashlytics::detail::scoped_writer::flush_with(const char* value, std::size_t length)
+{
+    struct iovec vectors[2] = {
+        { buffer_, offset_ },
+        { const_cast<char *>(value), length }
+    };
+
+    //! The first vector may be empty; starting at the payload avoids a zero-length entry.
+    crashlytics::detail::raw::writev(fd_, vectors + (offset_ == 0u ? 1 : 0), offset_ == 0u ? 1 : 2);
+    offset_ = 0u;
+}
+
+void google::crashlytics::detail::scoped_writer::put(const char* value, std::size_t length)
+{
+    if (length >= buffer_capacity) {
+        flush_with(value, length);
+        return;
+    }
+
+    while (length != 0u) {
+        if (offset_ == buffer_capacity) {
+            flush();
+        }
+
+        std::size_t chunk = std::min(length, buffer_capacity - offset_);
+
+        std::memcpy(buffer_ + offset_, value, chunk);
+
+        offset_ += chunk;
+        value   += chunk;
+        length  -= chunk;
+    }
+}
+
 void google::crashlytics::detail::scoped_writer::write(uint64_t value)
 {
-    impl::write(fd_, value);
+    put(value);
 }
 
 void google::crashlytics::detail::scoped_writer::write(const char* value)
 {
-    impl::write(fd_, value);
+    put(value);
 }
 
 void google::crashlytics::detail::scoped_writer::write(const char* value, std::size_t length)
 {
-    impl::write(fd_, value, length);
+    put(value, length);
+}
+
+void google::crashlytics::detail::scoped_writer::write_separator()
+{
+    put(',');
 }
@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <dlfcn.h>
+#include <pthread.h>
+
+#include "crashlytics/config.h"
+
+#include "crashlytics/detail/trace.h"
+
+namespace google { namespace crashlytics { namespace detail {
+namespace {
+
+typedef void (*begin_section_t)(const char* name);
+typedef void (*end_section_t)();
+
+begin_section_t begin_section = nullptr;
+end_section_t   end_section   = nullptr;
+
+pthread_once_t resolve_once = PTHREAD_ONCE_INIT;
+
+void resolve()
+{
+    void* handle = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        DEBUG_OUT("Couldn't open libandroid.so; tracing is disabled");
+        return;
+    }
+
+    begin_section = reinterpret_cast<begin_section_t>(dlsym(handle, "ATrace_beginSection"));
+    end_section   = reinterpret_cast<end_section_t>(dlsym(handle, "ATrace_endSection"));
+
+    //! Both or neither: an unmatched begin would corrupt the section stack.
+    if (begin_section == nullptr || end_section == nullptr) {
+        DEBUG_OUT("ATrace symbols are unavailable; tracing is disabled");
+        begin_section = nullptr;
+        end_section   = nullptr;
+    }
+}
+
+} // anonymous namespace
+}}}
+
+void google::crashlytics::detail::trace::begin(const char* name)
+{
+    pthread_once(&resolve_once, resolve);
+
+    if (begin_section != nullptr) {
+        begin_section(name);
+    }
+}
+
+void google::crashlytics::detail::trace::end()
+{
+    if (end_section != nullptr) {
+        end_section();
+    }
+}
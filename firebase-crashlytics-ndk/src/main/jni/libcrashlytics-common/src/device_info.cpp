@@ -12,35 +12,129 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cerrno>
+
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 
-#include "crashlytics/detail/scoped_writer.h"
+#include "crashlytics/detail/supplementary_file.h"
+#include "crashlytics/detail/stopwatch.h"
 #include "crashlytics/detail/system_info.h"
+#include "crashlytics/detail/system_info_region.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
 #include "crashlytics/detail/memory/allocate.h"
 
 #include "crashlytics/detail/device_info.h"
 
-void google::crashlytics::write_device_info(int fd)
+namespace google { namespace crashlytics {
+namespace {
+
+void collect_live(detail::system_info_region::sample& sample)
 {
     auto memory  = detail::memory_statistics();
     auto storage = detail::internal_storage_statistics();
 
+    sample.total_physical_memory      = memory.first;
+    sample.available_physical_memory  = memory.second;
+    sample.total_internal_storage     = storage.first;
+    sample.available_internal_storage = storage.second;
+    sample.battery                    = static_cast<uint64_t>(detail::battery_capacity());
+}
+
+//! Copies the latest sampler snapshot out of the region file. Returns false if
+//  the region is missing, truncated, or nothing has been published into it.
+bool collect_from_region(const char* region_path, detail::system_info_region::sample& sample)
+{
+    using detail::system_info_region;
+
+    int region_fd;
+    if ((region_fd = RECOVER_FROM_INTERRUPT(::open(region_path, O_RDONLY))) == -1) {
+        DEBUG_OUT("Couldn't open system-info region '%s'; %s", region_path, strerror(errno));
+        return false;
+    }
+
+    struct stat status;
+    if (::fstat(region_fd, &status) == -1 || static_cast<std::size_t>(status.st_size) < sizeof (system_info_region)) {
+        DEBUG_OUT("System-info region '%s' is truncated", region_path);
+        ::close(region_fd);
+        return false;
+    }
+
+    void* mapped = ::mmap(nullptr, sizeof (system_info_region), PROT_READ, MAP_SHARED, region_fd, 0);
+    ::close(region_fd);
+
+    if (mapped == MAP_FAILED) {
+        DEBUG_OUT("Couldn't map system-info region '%s'; %s", region_path, strerror(errno));
+        return false;
+    }
+
+    const system_info_region* region = static_cast<const system_info_region *>(mapped);
+    bool read = region->valid() && region->read_latest(sample);
+
+    ::munmap(mapped, sizeof (system_info_region));
+    return read;
+}
+
+void write_device_info_sample(int fd, const detail::system_info_region::sample& sample, const detail::stopwatch* timings)
+{
     // It is unsafe to fetch the orientation of the device at crash time via the
     // native API. Doing so causes some apps to hang indeffinitely. At this time
     // we will set the orientation to be unknown.
     auto orientation = static_cast<uint64_t>(/*ACONFIGURATION_ORIENTATION_ANY=*/ 0);
-    auto battery     = static_cast<uint64_t>(detail::battery_capacity());
 
-    using google::crashlytics::detail::scoped_writer;
+    using google::crashlytics::detail::supplementary_writer;
+
+    //! Durability is deferred to the directory sync at the end of the batch in
+    //  CrashpadHandlerMain.
+    supplementary_writer writer(fd, google::crashlytics::detail::NoSync);
+    supplementary_writer::wrapped object('{', '}', supplementary_writer::None, writer);
+
+    writer.write("orientation",                 orientation,                        supplementary_writer::Comma);
+    writer.write("total_physical_memory",       sample.total_physical_memory,       supplementary_writer::Comma);
+    writer.write("total_internal_storage",      sample.total_internal_storage,      supplementary_writer::Comma);
+    writer.write("available_physical_memory",   sample.available_physical_memory,   supplementary_writer::Comma);
+    writer.write("available_internal_storage",  sample.available_internal_storage,  supplementary_writer::Comma);
+    writer.write("battery",                     sample.battery,                     supplementary_writer::Comma);
+    writer.write("proximity_enabled",           false,
+                 timings != nullptr ? supplementary_writer::Comma : supplementary_writer::None);
+
+    if (timings != nullptr) {
+        detail::write_timings(writer, *timings);
+    }
+}
+
+} // anonymous namespace
+}} // namespace google::crashlytics
+
+void google::crashlytics::write_device_info(int fd)
+{
+    detail::system_info_region::sample sample {};
+
+    collect_live(sample);
+    write_device_info_sample(fd, sample, nullptr);
+}
+
+void google::crashlytics::write_device_info(int fd, const char* region_path)
+{
+    detail::system_info_region::sample sample {};
+
+    if (!collect_from_region(region_path, sample)) {
+        collect_live(sample);
+    }
+
+    write_device_info_sample(fd, sample, nullptr);
+}
+
+void google::crashlytics::write_device_info(int fd, const char* region_path, const detail::stopwatch& timings)
+{
+    detail::system_info_region::sample sample {};
 
-    scoped_writer writer(fd);
-    scoped_writer::wrapped object('{', '}', scoped_writer::None, writer);
+    if (!collect_from_region(region_path, sample)) {
+        collect_live(sample);
+    }
 
-    writer.write("orientation",                 orientation,                scoped_writer::Comma);
-    writer.write("total_physical_memory",       memory.first,               scoped_writer::Comma);
-    writer.write("total_internal_storage",      storage.first,              scoped_writer::Comma);
-    writer.write("available_physical_memory",   memory.second,              scoped_writer::Comma);
-    writer.write("available_internal_storage",  storage.second,             scoped_writer::Comma);
-    writer.write("battery",                     battery,                    scoped_writer::Comma);
-    writer.write("proximity_enabled",           false,                      scoped_writer::None);
+    write_device_info_sample(fd, sample, &timings);
 }
@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cerrno>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/supplementary_file.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+
+#include "crashlytics/detail/key_value_region.h"
+
+void google::crashlytics::detail::write_native_keys(int fd, const key_value_region& region)
+{
+    //! Synced as part of the supplementary batch; see CrashpadHandlerMain.
+    supplementary_writer writer(fd, NoSync);
+    supplementary_writer::wrapped object('{', '}', supplementary_writer::None, writer);
+
+    bool first = true;
+
+    region.snapshot([&](const char* key, const char* value) {
+        if (!first) {
+            writer.write_separator();
+        }
+
+        writer.write(key, value, supplementary_writer::None);
+        first = false;
+    });
+}
+
+bool google::crashlytics::detail::write_native_keys_file(const char* region_path, int fd)
+{
+    int region_fd;
+    if ((region_fd = RECOVER_FROM_INTERRUPT(::open(region_path, O_RDONLY))) == -1) {
+        DEBUG_OUT("Couldn't open key/value region '%s'; %s", region_path, strerror(errno));
+        return false;
+    }
+
+    struct stat status;
+    if (::fstat(region_fd, &status) == -1 || static_cast<std::size_t>(status.st_size) < sizeof (key_value_region)) {
+        DEBUG_OUT("Key/value region '%s' is truncated", region_path);
+        ::close(region_fd);
+        return false;
+    }
+
+    void* mapped = ::mmap(nullptr, sizeof (key_value_region), PROT_READ, MAP_SHARED, region_fd, 0);
+    ::close(region_fd);
+
+    if (mapped == MAP_FAILED) {
+        DEBUG_OUT("Couldn't map key/value region '%s'; %s", region_path, strerror(errno));
+        return false;
+    }
+
+    const key_value_region* region = static_cast<const key_value_region *>(mapped);
+    bool valid = region->valid();
+
+    if (valid) {
+        write_native_keys(fd, *region);
+    }
+
+    ::munmap(mapped, sizeof (key_value_region));
+    return valid;
+}
@@ -0,0 +1,39 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/supplementary_file.h"
+
+#include "crashlytics/detail/stopwatch.h"
+
+void google::crashlytics::detail::write_timings(supplementary_writer& writer, const stopwatch& timings)
+{
+    supplementary_writer::wrapped group("capture_timings", '{', '}', supplementary_writer::None, writer);
+
+    if (timings.count() == 0u) {
+        return;
+    }
+
+    uint64_t origin = timings.at(0u).nanoseconds;
+
+    for (std::size_t i = 0; i < timings.count(); ++i) {
+        const stopwatch::mark_entry& mark = timings.at(i);
+
+        writer.write(
+                mark.name,
+                (mark.nanoseconds - origin) / 1000u,
+                i + 1u < timings.count() ? supplementary_writer::Comma : supplementary_writer::None
+        );
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_EXTERNAL_API_H__
+#define __CRASHLYTICS_EXTERNAL_API_H__
+
+#include <jni.h>
+
+namespace google { namespace crashlytics { namespace api {
+
+//! Resolves the FirebaseCrashlytics class, its method ids and a global instance
+//  reference ahead of time, while we are already on a JVM thread during JNI_OnLoad.
+/*! This makes the first call to external_api_initialize a pointer exchange instead
+    of a series of JNI lookups on the caller's thread.
+ */
+bool preinitialize(JNIEnv* environment);
+
+}}} // namespace google::crashlytics::api
+
+#endif // __CRASHLYTICS_EXTERNAL_API_H__
@@ -69,6 +69,11 @@ inline void SetCustomKey(const char* key, int value);
 /// reports.
 inline void SetCustomKey(const char* key, long value);
 
+/// @brief Records a batch of custom keys and values in a single call, marshalling the
+/// whole batch across the native API boundary once. keys and values are parallel arrays
+/// of n entries each.
+inline void SetCustomKeys(const char* const* keys, const char* const* values, size_t n);
+
 /// @brief Records a user ID (identifier) that's associated with subsequent fatal and non-fatal
 /// reports.
 inline void SetUserId(const char* id);
@@ -84,12 +89,14 @@ typedef struct __crashlytics_unspecified                __crashlytics_unspecifie
 
 typedef __crashlytics_unspecified_t*    (*__crashlytics_initialize_t)           ();
 typedef void                            (*__crashlytics_set_internal_t)         (__crashlytics_unspecified_t *, const char *, const char *);
+typedef void                            (*__crashlytics_set_many_internal_t)    (__crashlytics_unspecified_t *, const char * const *, const char * const *, size_t);
 typedef void                            (*__crashlytics_log_internal_t)         (__crashlytics_unspecified_t *, const char *);
 typedef void                            (*__crashlytics_set_user_id_internal_t) (__crashlytics_unspecified_t *, const char *);
 typedef void                            (*__crashlytics_dispose_t)              (__crashlytics_unspecified_t *);
 
 struct __crashlytics_context {
     __crashlytics_set_internal_t __set;
+    __crashlytics_set_many_internal_t __set_many;
     __crashlytics_log_internal_t __log;
     __crashlytics_set_user_id_internal_t __set_user_id;
 
@@ -128,6 +135,21 @@ inline void SetCustomKey(const char* key, const char* value) {
     });
 }
 
+inline void SetCustomKeys(const char* const* keys, const char* const* values, size_t n) {
+    detail::invoke([&](const detail::__crashlytics_context_t* context) {
+        if (context->__set_many != nullptr) {
+            context->__set_many(context->__ctx, keys, values, n);
+            return;
+        }
+
+        // Older copies of libcrashlytics.so predate external_api_set_many; fall
+        // back to setting the pairs one at a time.
+        for (size_t i = 0; i < n; ++i) {
+            context->__set(context->__ctx, keys[i], values[i]);
+        }
+    });
+}
+
 inline void SetCustomKey(const char* key, bool value) {
     SetCustomKey(key, value ? "true" : "false");
 }
@@ -164,14 +186,15 @@ namespace detail {
     } while (0)
 
 inline __crashlytics_context_t* __crashlytics_construct(
-        __crashlytics_unspecified_t* ctx, void* sym_set, void* sym_log, void* sym_dispose, void* sym_set_user_id)  __CRASHLYTICS_DECORATED;
+        __crashlytics_unspecified_t* ctx, void* sym_set, void* sym_set_many, void* sym_log, void* sym_dispose, void* sym_set_user_id)  __CRASHLYTICS_DECORATED;
 inline __crashlytics_context_t* __crashlytics_construct(
-        __crashlytics_unspecified_t* ctx, void* sym_set, void* sym_log, void* sym_dispose, void* sym_set_user_id) {
+        __crashlytics_unspecified_t* ctx, void* sym_set, void* sym_set_many, void* sym_log, void* sym_dispose, void* sym_set_user_id) {
     __crashlytics_context_t* context;
 
     __CRASHLYTICS_NULL_ON_NULL(context = new __crashlytics_context_t);
 
     context->__set = (__crashlytics_set_internal_t) sym_set;
+    context->__set_many = (__crashlytics_set_many_internal_t) sym_set_many;
     context->__log = (__crashlytics_log_internal_t) sym_log;
     context->__set_user_id = (__crashlytics_set_user_id_internal_t) sym_set_user_id;
     context->__ctx = ctx;
@@ -190,6 +213,7 @@ inline __crashlytics_context_t* __crashlytics_init() {
     void* sym_ini;
     void* sym_log;
     void* sym_set;
+    void* sym_set_many;
     void* sym_dispose;
     void* sym_set_user_id;
 
@@ -200,6 +224,9 @@ inline __crashlytics_context_t* __crashlytics_init() {
     __CRASHLYTICS_NULL_ON_NULL(sym_dispose = dlsym(lib, "external_api_dispose"));
     __CRASHLYTICS_NULL_ON_NULL(sym_set_user_id = dlsym(lib, "external_api_set_user_id"));
 
+    // Optional; older copies of libcrashlytics.so don't export this symbol.
+    sym_set_many = dlsym(lib, "external_api_set_many");
+
     __crashlytics_unspecified_t* ctx = ((__crashlytics_initialize_t) sym_ini)();
 
     return ctx == __CRASHLYTICS_INITIALIZE_FAILURE
@@ -207,6 +234,7 @@ inline __crashlytics_context_t* __crashlytics_init() {
         : __crashlytics_construct(
             ctx,
             sym_set,
+            sym_set_many,
             sym_log,
             sym_dispose,
             sym_set_user_id
@@ -0,0 +1,30 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_EXTERNAL_DETAIL_BREADCRUMB_STORE_H__
+#define __CRASHLYTICS_EXTERNAL_DETAIL_BREADCRUMB_STORE_H__
+
+namespace google { namespace crashlytics { namespace api { namespace detail {
+
+//! Creates (or attaches to) the memory-mapped breadcrumb ring inside the
+//  crashpad database directory. Called once at handler installation time.
+bool initialize_breadcrumb_store(const char* database_path);
+
+//! Appends a message to the mapped ring with no syscalls. Returns false when
+//  the store is unavailable.
+bool store_breadcrumb(const char* message);
+
+}}}} // namespace google::crashlytics::api::detail
+
+#endif // __CRASHLYTICS_EXTERNAL_DETAIL_BREADCRUMB_STORE_H__
@@ -0,0 +1,31 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_EXTERNAL_DETAIL_KEY_VALUE_STORE_H__
+#define __CRASHLYTICS_EXTERNAL_DETAIL_KEY_VALUE_STORE_H__
+
+namespace google { namespace crashlytics { namespace api { namespace detail {
+
+//! Creates (or attaches to) the shared key/value region inside the crashpad
+//  database directory. Called once at handler installation time.
+bool initialize_key_value_store(const char* database_path);
+
+//! Records a custom key in the shared region, bypassing the JVM entirely.
+//  Returns false when the store is unavailable or full, in which case the
+//  caller should fall back to FirebaseCrashlytics.setCustomKey.
+bool store_key_value(const char* key, const char* value);
+
+}}}} // namespace google::crashlytics::api::detail
+
+#endif // __CRASHLYTICS_EXTERNAL_DETAIL_KEY_VALUE_STORE_H__
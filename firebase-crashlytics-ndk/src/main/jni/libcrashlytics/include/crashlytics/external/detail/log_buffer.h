@@ -0,0 +1,132 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_EXTERNAL_DETAIL_LOG_BUFFER_H__
+#define __CRASHLYTICS_EXTERNAL_DETAIL_LOG_BUFFER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace google { namespace crashlytics { namespace api { namespace detail {
+
+//! A bounded, lock-free multi-producer single-consumer ring of log messages.
+/*! Producers copy a message into a slot and publish it with a single release store;
+    the flusher thread is the only consumer. When the ring is full, messages are
+    dropped and counted rather than blocking the caller. Slot sequence numbers follow
+    the usual bounded-queue scheme: a slot is writable when its sequence matches the
+    producer ticket, and readable when it matches ticket + 1.
+ */
+struct log_buffer {
+    //! Must be a power of two.
+    static constexpr std::size_t capacity         = 256u;
+    static constexpr std::size_t message_capacity = 256u;
+
+    log_buffer();
+    log_buffer(const log_buffer &) = delete;
+
+    //! Copies the message into the ring. Returns false if the ring is full,
+    //  in which case the message is counted as dropped.
+    bool push(const char* message, std::size_t length);
+
+    //! Invokes func(data, length) for the oldest unconsumed message and releases
+    //  its slot. Returns false when the ring is empty. Only the flusher thread
+    //  may call this.
+    template<typename Func>
+    bool pop(Func func);
+
+    uint64_t dropped() const;
+
+private:
+    struct slot {
+        std::atomic<uint32_t> sequence;
+        uint16_t              length;
+        char                  data[message_capacity];
+    };
+
+    slot                  slots_[capacity];
+    std::atomic<uint32_t> enqueue_position_;
+    uint32_t              dequeue_position_;
+    std::atomic<uint64_t> dropped_;
+};
+
+}}}} // namespace google::crashlytics::api::detail
+
+//! implementation
+
+inline google::crashlytics::api::detail::log_buffer::log_buffer()
+    : enqueue_position_(0u), dequeue_position_(0u), dropped_(0u)
+{
+    for (uint32_t i = 0; i < capacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+inline bool google::crashlytics::api::detail::log_buffer::push(const char* message, std::size_t length)
+{
+    uint32_t position = enqueue_position_.load(std::memory_order_relaxed);
+    slot*    current;
+
+    for (;;) {
+        current = &slots_[position & (capacity - 1)];
+
+        uint32_t sequence = current->sequence.load(std::memory_order_acquire);
+        int32_t  difference = static_cast<int32_t>(sequence - position);
+
+        if (difference == 0) {
+            if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            dropped_.fetch_add(1u, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t bounded = std::min(length, message_capacity - 1);
+
+    std::memcpy(current->data, message, bounded);
+    current->data[bounded] = '\0';
+    current->length = static_cast<uint16_t>(bounded);
+
+    current->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Func>
+inline bool google::crashlytics::api::detail::log_buffer::pop(Func func)
+{
+    slot& current = slots_[dequeue_position_ & (capacity - 1)];
+
+    uint32_t sequence = current.sequence.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(sequence - (dequeue_position_ + 1)) < 0) {
+        return false;
+    }
+
+    func(current.data, static_cast<std::size_t>(current.length));
+
+    current.sequence.store(dequeue_position_ + capacity, std::memory_order_release);
+    ++dequeue_position_;
+    return true;
+}
+
+inline uint64_t google::crashlytics::api::detail::log_buffer::dropped() const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+#endif // __CRASHLYTICS_EXTERNAL_DETAIL_LOG_BUFFER_H__
@@ -0,0 +1,38 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_HANDLER_DETAIL_FALLBACK_WRITER_H__
+#define __CRASHLYTICS_HANDLER_DETAIL_FALLBACK_WRITER_H__
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+
+//! Installs the last-resort in-process dump stage. When crashpad can't spawn
+//  the handler process at crash time — likeliest on pre-Q, where the Java path
+//  forks an entire app_process out of a dying process — it restores the
+//  previous signal disposition and re-raises; installing this writer before
+//  crashpad makes it that disposition, so a degraded report still reaches the
+//  database directory. Crashpad re-raises after successful dumps too, so the
+//  writer checks for a fresh dump first and in either case chains onward to
+//  the disposition that was in place before it was installed. All buffers are
+//  allocated here, up front; the crash path itself allocates nothing.
+bool install_fallback_writer(const char* database_path);
+
+//! Re-stamps the freshness baseline the writer uses to tell a dump produced by
+//  this crash from older activity in the pending directory. Called after
+//  maintenance that touches that directory, such as pruning.
+void refresh_fallback_baseline();
+
+}}}} // namespace google::crashlytics::handler::detail
+
+#endif // __CRASHLYTICS_HANDLER_DETAIL_FALLBACK_WRITER_H__
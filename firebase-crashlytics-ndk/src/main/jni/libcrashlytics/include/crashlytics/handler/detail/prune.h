@@ -0,0 +1,29 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_HANDLER_DETAIL_PRUNE_H__
+#define __CRASHLYTICS_HANDLER_DETAIL_PRUNE_H__
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+
+//! Enforces the retention caps on the crashpad database: dumps beyond the
+//  count, byte or age limits are deleted oldest-first, together with their
+//  same-stem supplementary files, in a single walk per subdirectory. Run on
+//  the deferred installation thread, after the handlers are armed, so startup
+//  disk I/O stays proportional to the caps rather than to upload history.
+void prune_database(const char* database_path);
+
+}}}} // namespace google::crashlytics::handler::detail
+
+#endif // __CRASHLYTICS_HANDLER_DETAIL_PRUNE_H__
@@ -0,0 +1,30 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_HANDLER_DETAIL_SAMPLER_H__
+#define __CRASHLYTICS_HANDLER_DETAIL_SAMPLER_H__
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+
+//! Creates (or attaches to) the shared system-info region inside the crashpad
+//  database directory and starts a thread that refreshes it periodically, so
+//  the crash handler can copy a recent snapshot instead of reading /proc and
+//  sysfs at crash time. Called once at handler installation time; returns
+//  false if the region or the thread couldn't be set up, in which case the
+//  handler falls back to collecting the statistics live.
+bool start_system_info_sampler(const char* database_path);
+
+}}}} // namespace google::crashlytics::handler::detail
+
+#endif // __CRASHLYTICS_HANDLER_DETAIL_SAMPLER_H__
@@ -0,0 +1,34 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef __CRASHLYTICS_HANDLER_DETAIL_SHARED_HANDLER_H__
+#define __CRASHLYTICS_HANDLER_DETAIL_SHARED_HANDLER_H__
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+
+//! Connects to a handler socket advertised in the database directory by a sibling
+//  process, receives a duplicate of it, and hands it to the crashpad client. Returns
+//  false when no sibling is advertising — the caller then does its own full handler
+//  initialization.
+bool attach_shared_handler(const char* database_path);
+
+//! Advertises the given handler socket to sibling processes: takes the single-advertiser
+//  lock in the database directory, binds a socket next to it, and serves duplicates of
+//  handler_socket from a background thread. Best effort; when it fails, siblings simply
+//  fall back to initializing on their own.
+bool advertise_shared_handler(const char* database_path, int handler_socket);
+
+}}}} // namespace google::crashlytics::handler::detail
+
+#endif // __CRASHLYTICS_HANDLER_DETAIL_SHARED_HANDLER_H__
@@ -21,6 +21,13 @@ namespace detail { struct context; }
 //! Installs the crashlytics signal handler.
 /*! Relevant crash information is written to the provided file. This file is propagated to the backend
     via the java-side.
+
+    Installation is split in two (see install.cpp). The return value covers the
+    synchronous phase only: the stores are initialized, the pre-handler is armed, and
+    the deferred installation is either scheduled or, when its thread can't be
+    spawned, performed on the spot. A failure of the deferred phase is logged from
+    the installation thread and recorded in the installation state; it is not
+    reflected here.
  */
 bool install_handlers(detail::context context);
 
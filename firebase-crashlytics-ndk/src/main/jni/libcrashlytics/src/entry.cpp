@@ -28,9 +28,12 @@
 #endif
 
 #include "crashlytics/entry.h"
+#include "crashlytics/detail/memory/arena.h"
+#include "crashlytics/external/api.h"
 #include "crashlytics/handler/install.h"
 #include "crashlytics/handler/detail/context.h"
 #include "crashlytics/detail/supplementary_file.h"
+#include "crashlytics/detail/trace.h"
 #include "system/log.h"
 
 extern "C" {
@@ -87,9 +90,27 @@ pid_t this_pid()
     return getpid();
 }
 
-const char* data_path(JNIEnv* env, jstring path)
+std::size_t utf_length(JNIEnv* env, jstring string)
 {
-    return env->GetStringUTFChars(path, NULL);
+    return static_cast<std::size_t>(env->GetStringUTFLength(string));
+}
+
+//! Copies the string into the arena via GetStringUTFRegion, which writes straight into
+//  our storage; unlike GetStringUTFChars, there is nothing pinned in the JVM afterwards
+//  and nothing to release. Falls back to a pinned copy if the arena couldn't be mapped.
+const char* extract_string(JNIEnv* env, jstring string, crashlytics::detail::memory::arena& arena)
+{
+    std::size_t length = utf_length(env, string);
+
+    if (char* storage = arena.allocate(length + 1u)) {
+        env->GetStringUTFRegion(string, 0, env->GetStringLength(string), storage);
+
+        storage[length] = '\0';
+        return storage;
+    }
+
+    DEBUG_OUT("Couldn't copy into the init arena; pinning the string instead");
+    return env->GetStringUTFChars(string, NULL);
 }
 
 constexpr const char* ndk_path()
@@ -101,7 +122,15 @@ bool register_natives(JavaVM* jvm)
 {
     if (JNIEnv* env = get_environment(jvm)) {
         if (jclass crashlytics_class = find_class(env, ndk_path())) {
-            return register_natives(crashlytics_class, env, methods, sizeof methods / sizeof (methods[0]));
+            bool registered = register_natives(crashlytics_class, env, methods, sizeof methods / sizeof (methods[0]));
+
+            //! Resolving the external API bindings here is best effort; failing to do so
+            //  simply means the first external API call resolves them lazily, as before.
+            if (registered && !api::preinitialize(env)) {
+                DEBUG_OUT("Couldn't resolve the external API bindings at JNI_OnLoad");
+            }
+
+            return registered;
         }
     }
 
@@ -128,6 +157,10 @@ constexpr int libpath_ordinal() { return 1; }
 
 jboolean JNI_Init(JNIEnv* env, jobject obj, jobjectArray pathsArray, jobject asset_manager)
 {
+    google::crashlytics::detail::scoped_trace trace("Crashlytics#JNI_Init");
+
+    google::crashlytics::detail::trace::begin("Crashlytics#ExtractPaths");
+
     jstring path = static_cast<jstring>(
         env->GetObjectArrayElement(pathsArray, path_ordinal()));
 
@@ -137,15 +170,29 @@ jboolean JNI_Init(JNIEnv* env, jobject obj, jobjectArray pathsArray, jobject ass
     jstring lib_path = static_cast<jstring>(
         env->GetObjectArrayElement(pathsArray, libpath_ordinal()));
 
-    bool installed = google::crashlytics::handler::install_handlers({
+    //! One mapping holds all three path strings for the life of the process. The arena
+    //  object itself is automatic; the mapping behind it is never unmapped.
+    google::crashlytics::detail::memory::arena arena(
+            google::crashlytics::entry::jni::utf_length(env, path) +
+            google::crashlytics::entry::jni::utf_length(env, classpath) +
+            google::crashlytics::entry::jni::utf_length(env, lib_path) + 3u);
+
+    google::crashlytics::handler::detail::context handler_context {
             google::crashlytics::entry::jni::this_pid(),
-            google::crashlytics::entry::jni::data_path(env, path),
+            google::crashlytics::entry::jni::extract_string(env, path, arena),
             env,
-            env->GetStringUTFChars(classpath, 0),
-            env->GetStringUTFChars(lib_path, 0)
-    });
+            google::crashlytics::entry::jni::extract_string(env, classpath, arena),
+            google::crashlytics::entry::jni::extract_string(env, lib_path, arena)
+    };
+
+    google::crashlytics::detail::trace::end();
+
+    //! Handler installation is deferred (see install.cpp); this reports the
+    //  synchronous phase only. A deferred-phase failure is logged from the
+    //  installation thread and recorded in the installation state.
+    bool installed = google::crashlytics::handler::install_handlers(handler_context);
 
-    LOGD("Initializing native crash handling %s.", installed ? "successful" : "failed");
+    LOGD("Initializing native crash handling %s.", installed ? "accepted" : "failed");
     return installed;
 }
 
@@ -19,27 +19,52 @@
 #endif
 
 #include <jni.h>
+#include <algorithm>
 #include <atomic>
+#include <cstring>
 #include <new>
 #include <initializer_list>
+#include <pthread.h>
+
+#include "crashlytics/external/api.h"
+#include "crashlytics/external/detail/log_buffer.h"
+#include "crashlytics/external/detail/key_value_store.h"
+#include "crashlytics/external/detail/breadcrumb_store.h"
 
 namespace google { namespace crashlytics { namespace entry { namespace jni { namespace detail {
 
 extern std::atomic<JavaVM *> jvm;
 
+//! Threads that we attach stay attached, with a pthread TLS destructor detaching them
+//  exactly once at thread exit. This keeps repeated API calls from non-JVM threads from
+//  paying the AttachCurrentThread/DetachCurrentThread round trip on every call.
+pthread_key_t  environment_key;
+pthread_once_t environment_key_once = PTHREAD_ONCE_INIT;
+
+void detach_on_thread_exit(void *)
+{
+    if (JavaVM* vm = jvm.load()) {
+        DEBUG_OUT("Detaching thread from the JVM");
+        vm->DetachCurrentThread();
+    }
+}
+
+void make_environment_key()
+{
+    pthread_key_create(&environment_key, detach_on_thread_exit);
+}
+
 struct managed_environment {
     managed_environment(JavaVM* jvm);
-   ~managed_environment();
 
     JNIEnv* get() const;
 private:
     JavaVM* jvm_;
     JNIEnv* environment_;
-    bool    attached_;
 };
 
 managed_environment::managed_environment(JavaVM* jvm)
-    : jvm_(jvm), environment_(NULL), attached_(false)
+    : jvm_(jvm), environment_(NULL)
 {
     if (jvm_ == NULL) {
         return;
@@ -50,23 +75,16 @@ managed_environment::managed_environment(JavaVM* jvm)
         DEBUG_OUT("Calling JNI method from a non JVM thread, attaching...");
         if (jvm_->AttachCurrentThread(&environment_, NULL) != 0) {
             DEBUG_OUT("Failed to attach!");
-            attached_ = false;
             break;
         }
         DEBUG_OUT("Attached successfully!");
-        attached_ = true;
+        pthread_once(&environment_key_once, make_environment_key);
+        pthread_setspecific(environment_key, environment_);
     case JNI_OK:
         return;
     }
 }
 
-managed_environment::~managed_environment()
-{
-    if (attached_) {
-        jvm_->DetachCurrentThread();
-    }
-}
-
 JNIEnv* managed_environment::get() const
 {
     return environment_;
@@ -92,6 +110,35 @@ public:
     jmethodID      set_user_id_;
 };
 
+//! Resolves the FirebaseCrashlytics bindings on the given environment. Returns
+//  null if any of the lookups fail.
+jvm_context* make_context(JNIEnv* environment);
+
+//! Holds a context resolved during JNI_OnLoad, if preinitialization ran. Ownership
+//  is transferred to the first caller of external_api_initialize.
+std::atomic<jvm_context *> preinitialized { nullptr };
+
+//! Log messages are pushed into a lock-free ring on the caller's thread and drained
+//  by a dedicated flusher thread, which coalesces bursts into batched JNI calls.
+log_buffer& logs();
+
+//! Enqueues the message for the flusher thread. Returns false if the flusher isn't
+//  available, in which case the caller should fall back to a synchronous crossing.
+bool enqueue_log(jvm_context* context, const char* message);
+
+std::atomic<jvm_context *> flusher_context  { nullptr };
+std::atomic<bool>          flusher_running  { false };
+std::atomic<bool>          flusher_pending  { false };
+
+pthread_mutex_t            flusher_mutex  = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t             flusher_wakeup = PTHREAD_COND_INITIALIZER;
+pthread_cond_t             flusher_idle   = PTHREAD_COND_INITIALIZER;
+pthread_once_t             flusher_once   = PTHREAD_ONCE_INIT;
+
+//! True while the flusher is draining with a claimed context; guarded by
+//  flusher_mutex. external_api_dispose waits on it before freeing the context.
+bool                       flusher_draining = false;
+
 }}}}
 
 //! Implementation
@@ -116,6 +163,9 @@ void external_api_dispose(
     google::crashlytics::api::detail::jvm_context* context)                                     __attribute__((visibility ("default")));
 void external_api_set(
     google::crashlytics::api::detail::jvm_context* context, const char* key, const char* value) __attribute__((visibility ("default")));
+void external_api_set_many(
+    google::crashlytics::api::detail::jvm_context* context,
+    const char* const* keys, const char* const* values, std::size_t count)                      __attribute__((visibility ("default")));
 void external_api_log(
     google::crashlytics::api::detail::jvm_context* context, const char* message)                __attribute__((visibility ("default")));
 void external_api_set_user_id(
@@ -123,10 +173,8 @@ void external_api_set_user_id(
 
 }
 
-google::crashlytics::api::detail::jvm_context* external_api_initialize()
+google::crashlytics::api::detail::jvm_context* google::crashlytics::api::detail::make_context(JNIEnv* environment)
 {
-    DEBUG_OUT("Initializing API context...");
-
     jclass     crashlytics;
     jclass     crashlytics_global;
     jmethodID  crashlytics_log;
@@ -135,16 +183,6 @@ google::crashlytics::api::detail::jvm_context* external_api_initialize()
     jmethodID  crashlytics_get_instance;
     jobject    crashlytics_instance;
     jobject    crashlytics_instance_global;
-    JNIEnv*    environment;
-
-    google::crashlytics::entry::jni::detail::managed_environment env(
-        google::crashlytics::entry::jni::detail::jvm.load()
-    );
-
-    if ((environment = env.get()) == NULL) {
-        DEBUG_OUT("Global environment not set.");
-        return nullptr;
-    }
 
     if ((crashlytics = environment->FindClass("com/google/firebase/crashlytics/FirebaseCrashlytics")) == NULL) {
         DEBUG_OUT("Couldn't find com/google/firebase/crashlytics/FirebaseCrashlytics");
@@ -195,9 +233,76 @@ google::crashlytics::api::detail::jvm_context* external_api_initialize()
     );
 }
 
+bool google::crashlytics::api::preinitialize(JNIEnv* environment)
+{
+    DEBUG_OUT("Preinitializing API context...");
+
+    if (environment == NULL) {
+        return false;
+    }
+
+    detail::jvm_context* context = detail::make_context(environment);
+
+    if (context == nullptr) {
+        //! Resolution can leave a pending exception (e.g. ClassNotFoundException), which
+        //  must not escape JNI_OnLoad. Lazy initialization at first use remains available.
+        if (environment->ExceptionCheck()) {
+            environment->ExceptionClear();
+        }
+
+        DEBUG_OUT("Couldn't preinitialize the API context");
+        return false;
+    }
+
+    delete detail::preinitialized.exchange(context);
+    return true;
+}
+
+google::crashlytics::api::detail::jvm_context* external_api_initialize()
+{
+    DEBUG_OUT("Initializing API context...");
+
+    if (google::crashlytics::api::detail::jvm_context* context =
+            google::crashlytics::api::detail::preinitialized.exchange(nullptr)) {
+        DEBUG_OUT("Using the context resolved at JNI_OnLoad");
+        return context;
+    }
+
+    JNIEnv* environment;
+
+    google::crashlytics::entry::jni::detail::managed_environment env(
+        google::crashlytics::entry::jni::detail::jvm.load()
+    );
+
+    if ((environment = env.get()) == NULL) {
+        DEBUG_OUT("Global environment not set.");
+        return nullptr;
+    }
+
+    return google::crashlytics::api::detail::make_context(environment);
+}
+
 void external_api_dispose(google::crashlytics::api::detail::jvm_context* context)
 {
     DEBUG_OUT("Finalizing API context");
+
+    //! The flusher claims the context pointer under the mutex; clearing it under
+    //  the same mutex and waiting out an in-flight drain closes the window where
+    //  the flusher could still touch the context after it is freed.
+    pthread_mutex_lock(&google::crashlytics::api::detail::flusher_mutex);
+
+    google::crashlytics::api::detail::jvm_context* expected = context;
+    google::crashlytics::api::detail::flusher_context.compare_exchange_strong(expected, nullptr);
+
+    while (google::crashlytics::api::detail::flusher_draining) {
+        pthread_cond_wait(
+                &google::crashlytics::api::detail::flusher_idle,
+                &google::crashlytics::api::detail::flusher_mutex
+        );
+    }
+
+    pthread_mutex_unlock(&google::crashlytics::api::detail::flusher_mutex);
+
     delete context;
 }
 
@@ -275,6 +380,93 @@ void invoke2(JNIEnv* environment, jobject crashlytics_core, jmethodID method, co
     environment->CallVoidMethod(crashlytics_core, method, marshalled1.get(), marshalled2.get());
 }
 
+//! Interns the jstrings for custom-key names, which tend to repeat across calls.
+/*! Entries hold global references and are never evicted; once the cache is full,
+    additional names marshal a transient jstring per call as before.
+ */
+struct jstring_cache {
+    static constexpr std::size_t capacity     = 32u;
+    static constexpr std::size_t key_capacity = 64u;
+
+    jstring get(JNIEnv* environment, const char* key);
+
+private:
+    struct entry {
+        char    key[key_capacity];
+        jstring interned;
+    };
+
+    entry           entries_[capacity] = {};
+    std::size_t     size_              = 0u;
+    pthread_mutex_t mutex_             = PTHREAD_MUTEX_INITIALIZER;
+};
+
+jstring jstring_cache::get(JNIEnv* environment, const char* key)
+{
+    std::size_t length = std::strlen(key);
+
+    if (length >= key_capacity) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&mutex_);
+
+    for (std::size_t i = 0; i < size_; ++i) {
+        if (std::strncmp(entries_[i].key, key, key_capacity) == 0) {
+            jstring interned = entries_[i].interned;
+            pthread_mutex_unlock(&mutex_);
+            return interned;
+        }
+    }
+
+    jstring interned = NULL;
+
+    if (size_ < capacity) {
+        managed_jstring marshalled(environment, key);
+
+        if (marshalled && (interned = static_cast<jstring>(environment->NewGlobalRef(marshalled.get()))) != NULL) {
+            std::memcpy(entries_[size_].key, key, length + 1);
+            entries_[size_].interned = interned;
+            ++size_;
+        }
+    }
+
+    pthread_mutex_unlock(&mutex_);
+    return interned;
+}
+
+jstring_cache& key_names()
+{
+    static jstring_cache cache;
+    return cache;
+}
+
+//! Invokes a two-argument method whose first argument is a custom-key name, using
+//  the interned jstring for the name when available.
+void invoke2_interned(JNIEnv* environment, jobject crashlytics_core, jmethodID method, const char* key, const char* value)
+{
+    if (environment == NULL || crashlytics_core == NULL) {
+        DEBUG_OUT("Failed to invoke method due to environmental issues");
+        return;
+    }
+
+    jstring interned = key_names().get(environment, key);
+
+    if (interned == NULL) {
+        invoke2(environment, crashlytics_core, method, key, value);
+        return;
+    }
+
+    managed_jstring marshalled2(environment, value);
+
+    if (!marshalled2) {
+        DEBUG_OUT("Couldn't allocate a new marshalled string in %s", __PRETTY_FUNCTION__);
+        return;
+    }
+
+    environment->CallVoidMethod(crashlytics_core, method, interned, marshalled2.get());
+}
+
 void invokeN(JNIEnv* environment, jobject crashlytics_core, jmethodID method, std::initializer_list<const char *> arguments)
 {
     if (environment == NULL || crashlytics_core == NULL) {
@@ -294,6 +486,109 @@ void invokeN(JNIEnv* environment, jobject crashlytics_core, jmethodID method, st
 
 }}}
 
+namespace google { namespace crashlytics { namespace api { namespace detail {
+
+log_buffer& logs()
+{
+    static log_buffer buffer;
+    return buffer;
+}
+
+namespace {
+
+constexpr std::size_t message_capacity = 16384u;
+
+//! Drains pending messages one FirebaseCrashlytics.log invocation each, so every
+//  breadcrumb remains its own log record; the thread attach and the method
+//  lookups are still amortized across the burst.
+void drain(JNIEnv* environment, jvm_context* context, char* scratch)
+{
+    while (logs().pop([&](const char* data, std::size_t length) {
+        std::size_t bounded = std::min(length, message_capacity - 1u);
+
+        std::memcpy(scratch, data, bounded);
+        scratch[bounded] = '\0';
+
+        google::crashlytics::detail::invoke1(environment, context->crashlytics_, context->log_, scratch);
+    })) {
+    }
+}
+
+void* flusher_main(void *)
+{
+    static char scratch[message_capacity];
+
+    for (;;) {
+        pthread_mutex_lock(&flusher_mutex);
+        while (!flusher_pending.exchange(false, std::memory_order_acquire)) {
+            pthread_cond_wait(&flusher_wakeup, &flusher_mutex);
+        }
+
+        //! The context is claimed under the mutex, so external_api_dispose can
+        //  null it out and wait for the drain to finish before freeing it.
+        jvm_context* context = flusher_context.load();
+        flusher_draining = context != nullptr;
+        pthread_mutex_unlock(&flusher_mutex);
+
+        //! The flusher attaches once and stays attached; see managed_environment.
+        google::crashlytics::entry::jni::detail::managed_environment env(
+            google::crashlytics::entry::jni::detail::jvm.load()
+        );
+
+        if (context != nullptr) {
+            if (env.get() != NULL) {
+                drain(env.get(), context, scratch);
+            }
+
+            pthread_mutex_lock(&flusher_mutex);
+            flusher_draining = false;
+            pthread_cond_broadcast(&flusher_idle);
+            pthread_mutex_unlock(&flusher_mutex);
+        }
+    }
+
+    return nullptr;
+}
+
+void start_flusher()
+{
+    pthread_t thread;
+
+    if (pthread_create(&thread, nullptr, flusher_main, nullptr) != 0) {
+        DEBUG_OUT("Couldn't start the log flusher thread");
+        return;
+    }
+
+    pthread_detach(thread);
+    flusher_running.store(true);
+}
+
+} // anonymous namespace
+
+bool enqueue_log(jvm_context* context, const char* message)
+{
+    flusher_context.store(context, std::memory_order_relaxed);
+    pthread_once(&flusher_once, start_flusher);
+
+    if (!flusher_running.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    //! If the ring is full the message is dropped by design; falling back to a
+    //  synchronous crossing here would defeat the bounded queue under load.
+    logs().push(message, std::strlen(message));
+
+    if (!flusher_pending.exchange(true, std::memory_order_release)) {
+        pthread_mutex_lock(&flusher_mutex);
+        pthread_cond_signal(&flusher_wakeup);
+        pthread_mutex_unlock(&flusher_mutex);
+    }
+
+    return true;
+}
+
+}}}}
+
 void external_api_set(google::crashlytics::api::detail::jvm_context* context, const char* key, const char* value)
 {
     if (google::crashlytics::detail::null_context(context) || key == NULL || value == NULL) {
@@ -302,8 +597,42 @@ void external_api_set(google::crashlytics::api::detail::jvm_context* context, co
     }
 
     DEBUG_OUT("set: %s = %s", key, value);
+
+    //! The shared-memory store only gives the NDK handler a crash-time snapshot;
+    //  the JVM side remains the system of record for every uploaded report, so
+    //  the pair crosses regardless of whether the store accepted it.
+    google::crashlytics::api::detail::store_key_value(key, value);
+
     google::crashlytics::entry::jni::detail::managed_environment env(google::crashlytics::entry::jni::detail::jvm.load());
-    google::crashlytics::detail::invokeN(env.get(), context->crashlytics_, context->set_, { key, value });
+    google::crashlytics::detail::invoke2_interned(env.get(), context->crashlytics_, context->set_, key, value);
+}
+
+void external_api_set_many(
+    google::crashlytics::api::detail::jvm_context* context,
+    const char* const* keys, const char* const* values, std::size_t count)
+{
+    if (google::crashlytics::detail::null_context(context) || keys == NULL || values == NULL) {
+        DEBUG_OUT("Context and arguments can't be NULL");
+        return;
+    }
+
+    DEBUG_OUT("set_many: %u pairs", static_cast<unsigned int>(count));
+
+    //! The environment is resolved once for the whole batch, so every pair
+    //  shares a single attach and crossing setup.
+    google::crashlytics::entry::jni::detail::managed_environment env(google::crashlytics::entry::jni::detail::jvm.load());
+
+    for (std::size_t i = 0; i < count; ++i) {
+        if (keys[i] == NULL || values[i] == NULL) {
+            continue;
+        }
+
+        //! Snapshot for the NDK handler; the JVM call below is what feeds the
+        //  uploaded reports. See external_api_set.
+        google::crashlytics::api::detail::store_key_value(keys[i], values[i]);
+
+        google::crashlytics::detail::invoke2_interned(env.get(), context->crashlytics_, context->set_, keys[i], values[i]);
+    }
 }
 
 void external_api_log(google::crashlytics::api::detail::jvm_context* context, const char* message)
@@ -314,6 +643,15 @@ void external_api_log(google::crashlytics::api::detail::jvm_context* context, co
     }
 
     DEBUG_OUT("log: %s", message);
+
+    //! The mapped ring is what the crash handler reads at crash time; the JVM path
+    //  below still feeds breadcrumbs into non-fatal and JVM crash reports.
+    google::crashlytics::api::detail::store_breadcrumb(message);
+
+    if (google::crashlytics::api::detail::enqueue_log(context, message)) {
+        return;
+    }
+
     google::crashlytics::entry::jni::detail::managed_environment env(google::crashlytics::entry::jni::detail::jvm.load());
     google::crashlytics::detail::invokeN(env.get(), context->crashlytics_, context->log_, { message });
 }
@@ -345,6 +683,7 @@ void force_crashlytics_h_to_compile_as_cplusplus()
 
     Log("message");
     SetCustomKey("key", "value");
+    SetCustomKeys(nullptr, nullptr, 0);
     SetUserId("user");
 
     Terminate();
@@ -353,6 +692,7 @@ void force_crashlytics_h_to_compile_as_cplusplus()
     external_api_initialize();
     external_api_dispose(nullptr);
     external_api_set(nullptr, "", "");
+    external_api_set_many(nullptr, nullptr, nullptr, 0);
     external_api_log(nullptr, "");
     external_api_set_user_id(nullptr, "");
 }
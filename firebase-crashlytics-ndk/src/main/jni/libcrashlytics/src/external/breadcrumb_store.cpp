@@ -0,0 +1,100 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/breadcrumb_region.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+
+#include "crashlytics/external/detail/breadcrumb_store.h"
+
+namespace google { namespace crashlytics { namespace api { namespace detail {
+namespace {
+
+std::atomic<google::crashlytics::detail::breadcrumb_region *> region { nullptr };
+
+} // anonymous namespace
+}}}}
+
+bool google::crashlytics::api::detail::initialize_breadcrumb_store(const char* database_path)
+{
+    using google::crashlytics::detail::breadcrumb_region;
+    using google::crashlytics::detail::breadcrumb_region_name;
+
+    if (region.load(std::memory_order_acquire) != nullptr) {
+        return true;
+    }
+
+    std::string path { database_path };
+    path += "/";
+    path += breadcrumb_region_name();
+
+    int fd;
+    if ((fd = RECOVER_FROM_INTERRUPT(::open(path.c_str(), O_RDWR | O_CREAT, 0600))) == -1) {
+        DEBUG_OUT("Couldn't open breadcrumb region '%s'; %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (::ftruncate(fd, sizeof (breadcrumb_region)) == -1) {
+        DEBUG_OUT("Couldn't size breadcrumb region '%s'; %s", path.c_str(), strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = ::mmap(nullptr, sizeof (breadcrumb_region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        DEBUG_OUT("Couldn't map breadcrumb region '%s'; %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    breadcrumb_region* mapped_region = static_cast<breadcrumb_region *>(mapped);
+
+    //! As with the key/value region, racing initializers are harmless; the magic is
+    //  published with a release store over zeroed entries.
+    if (!mapped_region->valid()) {
+        mapped_region->initialize();
+    }
+
+    breadcrumb_region* expected = nullptr;
+    if (!region.compare_exchange_strong(expected, mapped_region, std::memory_order_release)) {
+        ::munmap(mapped, sizeof (breadcrumb_region));
+    }
+
+    DEBUG_OUT("Breadcrumb region is at %s", path.c_str());
+    return true;
+}
+
+bool google::crashlytics::api::detail::store_breadcrumb(const char* message)
+{
+    google::crashlytics::detail::breadcrumb_region* attached = region.load(std::memory_order_acquire);
+
+    if (attached == nullptr) {
+        return false;
+    }
+
+    attached->append(message, std::strlen(message));
+    return true;
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <string>
+#include <cerrno>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/key_value_region.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+
+#include "crashlytics/external/detail/key_value_store.h"
+
+namespace google { namespace crashlytics { namespace api { namespace detail {
+namespace {
+
+std::atomic<google::crashlytics::detail::key_value_region *> region { nullptr };
+
+} // anonymous namespace
+}}}}
+
+bool google::crashlytics::api::detail::initialize_key_value_store(const char* database_path)
+{
+    using google::crashlytics::detail::key_value_region;
+    using google::crashlytics::detail::key_value_region_name;
+
+    if (region.load(std::memory_order_acquire) != nullptr) {
+        return true;
+    }
+
+    std::string path { database_path };
+    path += "/";
+    path += key_value_region_name();
+
+    int fd;
+    if ((fd = RECOVER_FROM_INTERRUPT(::open(path.c_str(), O_RDWR | O_CREAT, 0600))) == -1) {
+        DEBUG_OUT("Couldn't open key/value region '%s'; %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (::ftruncate(fd, sizeof (key_value_region)) == -1) {
+        DEBUG_OUT("Couldn't size key/value region '%s'; %s", path.c_str(), strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = ::mmap(nullptr, sizeof (key_value_region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        DEBUG_OUT("Couldn't map key/value region '%s'; %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    key_value_region* mapped_region = static_cast<key_value_region *>(mapped);
+
+    //! Several app processes may race here; initialize() publishes the magic with a
+    //  release store over zeroed slots, so a duplicate stamp is harmless.
+    if (!mapped_region->valid()) {
+        mapped_region->initialize();
+    }
+
+    key_value_region* expected = nullptr;
+    if (!region.compare_exchange_strong(expected, mapped_region, std::memory_order_release)) {
+        ::munmap(mapped, sizeof (key_value_region));
+    }
+
+    DEBUG_OUT("Key/value region is at %s", path.c_str());
+    return true;
+}
+
+bool google::crashlytics::api::detail::store_key_value(const char* key, const char* value)
+{
+    google::crashlytics::detail::key_value_region* attached = region.load(std::memory_order_acquire);
+    return attached != nullptr && attached->set(key, value);
+}
@@ -0,0 +1,328 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+#include <ctime>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/ucontext.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/fgets_safe.h"
+#include "crashlytics/detail/scoped_writer.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+#include "crashlytics/detail/syscall_io.h"
+#include "crashlytics/detail/memory/allocate.h"
+
+#include "crashlytics/handler/detail/fallback_writer.h"
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+namespace {
+
+constexpr int fallback_signals[] = { SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV, SIGTRAP };
+constexpr std::size_t fallback_signal_count = sizeof fallback_signals / sizeof fallback_signals[0];
+
+constexpr std::size_t stack_capture_capacity = 16u * 1024u;
+constexpr std::size_t register_capacity      = 40u;
+
+//! Everything the crash path touches, allocated once at installation time via
+//  the page allocator so the signal handler itself allocates nothing.
+struct fallback_buffers {
+    char     report_path[320];
+    char     pending_path[320];
+    time_t   baseline;
+    char     line[512];
+    char     stack_hex[stack_capture_capacity * 2u + 1u];
+    uint64_t registers[register_capacity];
+};
+
+fallback_buffers* buffers = nullptr;
+
+//! The dispositions in place before this writer was installed, indexed in step
+//  with fallback_signals; the handler chains to them instead of forcing the
+//  default, preserving whatever was there first — on the deferred-install path
+//  that is the pre-handler, which in turn chains to debuggerd's tombstone
+//  handler.
+struct sigaction previous_actions[fallback_signal_count];
+
+std::size_t capture_registers(const ucontext_t* context, uint64_t& pc, uint64_t& sp)
+{
+    uint64_t* registers = buffers->registers;
+
+#if defined (__aarch64__)
+    for (std::size_t i = 0; i < 31u; ++i) {
+        registers[i] = context->uc_mcontext.regs[i];
+    }
+
+    sp = context->uc_mcontext.sp;
+    pc = context->uc_mcontext.pc;
+    return 31u;
+#elif defined (__arm__)
+    uint32_t values[] = {
+        context->uc_mcontext.arm_r0, context->uc_mcontext.arm_r1,
+        context->uc_mcontext.arm_r2, context->uc_mcontext.arm_r3,
+        context->uc_mcontext.arm_r4, context->uc_mcontext.arm_r5,
+        context->uc_mcontext.arm_r6, context->uc_mcontext.arm_r7,
+        context->uc_mcontext.arm_r8, context->uc_mcontext.arm_r9,
+        context->uc_mcontext.arm_r10, context->uc_mcontext.arm_fp,
+        context->uc_mcontext.arm_ip, context->uc_mcontext.arm_sp,
+        context->uc_mcontext.arm_lr, context->uc_mcontext.arm_pc
+    };
+
+    for (std::size_t i = 0; i < sizeof values / sizeof (values[0]); ++i) {
+        registers[i] = values[i];
+    }
+
+    sp = context->uc_mcontext.arm_sp;
+    pc = context->uc_mcontext.arm_pc;
+    return sizeof values / sizeof (values[0]);
+#elif defined (__x86_64__)
+    for (int i = 0; i < NGREG; ++i) {
+        registers[i] = static_cast<uint64_t>(context->uc_mcontext.gregs[i]);
+    }
+
+    sp = static_cast<uint64_t>(context->uc_mcontext.gregs[REG_RSP]);
+    pc = static_cast<uint64_t>(context->uc_mcontext.gregs[REG_RIP]);
+    return static_cast<std::size_t>(NGREG);
+#elif defined (__i386__)
+    for (int i = 0; i < NGREG; ++i) {
+        registers[i] = static_cast<uint64_t>(static_cast<uint32_t>(context->uc_mcontext.gregs[i]));
+    }
+
+    sp = static_cast<uint32_t>(context->uc_mcontext.gregs[REG_ESP]);
+    pc = static_cast<uint32_t>(context->uc_mcontext.gregs[REG_EIP]);
+    return static_cast<std::size_t>(NGREG);
+#else
+    (void) context;
+    sp = pc = 0;
+    return 0;
+#endif
+}
+
+//! A single pass over /proc/self/maps: streams the executable modules into the
+//  report and finds the end of the mapping holding the stack pointer, which
+//  bounds how much of the stack can be copied without faulting.
+uint64_t write_modules_and_find_stack_end(crashlytics::detail::scoped_writer& writer, uint64_t sp)
+{
+    using crashlytics::detail::scoped_writer;
+
+    uint64_t stack_end = 0;
+
+    int fd = RECOVER_FROM_INTERRUPT(crashlytics::detail::raw::open("/proc/self/maps", O_RDONLY));
+
+    scoped_writer::wrapped array("modules", '[', ']', scoped_writer::None, writer);
+
+    if (fd == -1) {
+        return stack_end;
+    }
+
+    bool first = true;
+
+    while (crashlytics::detail::fgets_safe(fd, buffers->line, sizeof buffers->line, false) != nullptr) {
+        if (char* line_break = std::strchr(buffers->line, '|')) {
+            *line_break = '\0';
+        }
+
+        //! The assumption here is that strtoull is async safe, matching what
+        //  extract() in system_info.h already assumes of strtol.
+        char*    end = nullptr;
+        uint64_t start = std::strtoull(buffers->line, &end, 16);
+        uint64_t finish = end != nullptr && *end == '-' ? std::strtoull(end + 1, &end, 16) : 0;
+
+        if (sp >= start && sp < finish) {
+            stack_end = finish;
+        }
+
+        const char* path = std::strchr(buffers->line, '/');
+        if (path != nullptr && std::strstr(buffers->line, " r-xp ") != nullptr) {
+            if (!first) {
+                writer.write_separator();
+            }
+
+            writer.write(path);
+            first = false;
+        }
+    }
+
+    crashlytics::detail::raw::close(fd);
+    return stack_end;
+}
+
+std::size_t capture_stack(uint64_t sp, uint64_t stack_end)
+{
+    if (sp == 0 || stack_end <= sp) {
+        return 0;
+    }
+
+    std::size_t length = stack_end - sp < stack_capture_capacity ? static_cast<std::size_t>(stack_end - sp) : stack_capture_capacity;
+    const unsigned char* stack = reinterpret_cast<const unsigned char *>(static_cast<uintptr_t>(sp));
+
+    constexpr char digits[] = "0123456789abcdef";
+
+    for (std::size_t i = 0; i < length; ++i) {
+        buffers->stack_hex[i * 2u]      = digits[stack[i] >> 4u];
+        buffers->stack_hex[i * 2u + 1u] = digits[stack[i] & 0x0fu];
+    }
+
+    buffers->stack_hex[length * 2u] = '\0';
+    return length;
+}
+
+void write_fallback_report(int signal, siginfo_t* info, const ucontext_t* context)
+{
+    using crashlytics::detail::scoped_writer;
+
+    int fd = crashlytics::detail::open(buffers->report_path);
+    if (fd == -1) {
+        return;
+    }
+
+    uint64_t pc = 0;
+    uint64_t sp = 0;
+
+    std::size_t register_count = capture_registers(context, pc, sp);
+
+    scoped_writer writer(fd);
+    scoped_writer::wrapped object('{', '}', scoped_writer::None, writer);
+
+    writer.write("signal",        static_cast<uint64_t>(signal), scoped_writer::Comma);
+    writer.write("code",          static_cast<uint64_t>(info->si_code), scoped_writer::Comma);
+    writer.write("fault_address", static_cast<uint64_t>(reinterpret_cast<uintptr_t>(info->si_addr)), scoped_writer::Comma);
+    writer.write("pc",            pc, scoped_writer::Comma);
+    writer.write("sp",            sp, scoped_writer::Comma);
+
+    writer.write_array(
+            "registers", buffers->registers, buffers->registers + register_count,
+            [](uint64_t value, scoped_writer& w) { w.write(value); },
+            scoped_writer::Comma
+    );
+
+    uint64_t stack_end = write_modules_and_find_stack_end(writer, sp);
+
+    if (capture_stack(sp, stack_end) != 0) {
+        writer.write_separator();
+        writer.write("stack", static_cast<const char *>(buffers->stack_hex), scoped_writer::None);
+    }
+}
+
+//! Whether a dump landed in the pending directory since the baseline was last
+//  stamped. Crashpad's handler processes are the only writers there between
+//  stamps — the pruner re-stamps after running — so fresh activity means this
+//  crash was captured.
+/*! The assumption here is that stat is async signal safe, as POSIX lists it,
+    matching what write_modules_and_find_stack_end already assumes of strtoull.
+ */
+bool dump_already_written()
+{
+    struct stat status;
+
+    if (::stat(buffers->pending_path, &status) != 0) {
+        return false;
+    }
+
+    return status.st_mtime > buffers->baseline;
+}
+
+void restore_previous_action(int signal)
+{
+    for (std::size_t i = 0; i < fallback_signal_count; ++i) {
+        if (fallback_signals[i] == signal) {
+            sigaction(signal, &previous_actions[i], nullptr);
+            return;
+        }
+    }
+
+    struct sigaction default_action;
+    std::memset(&default_action, 0, sizeof default_action);
+    default_action.sa_handler = SIG_DFL;
+
+    sigaction(signal, &default_action, nullptr);
+}
+
+void fallback_handler(int signal, siginfo_t* info, void* context)
+{
+    //! Crashpad restores the disposition it saved — this one — and re-raises
+    //  both when it fails to spawn the handler process and after a successful
+    //  dump. The degraded report is only worth writing when no dump landed.
+    if (buffers != nullptr && !dump_already_written()) {
+        write_fallback_report(signal, info, static_cast<const ucontext_t *>(context));
+    }
+
+    restore_previous_action(signal);
+    raise(signal);
+}
+
+} // anonymous namespace
+}}}}
+
+bool google::crashlytics::handler::detail::install_fallback_writer(const char* database_path)
+{
+    if (buffers != nullptr) {
+        return true;
+    }
+
+    constexpr const char* report_name  = "/last_resort.native_crash";
+    constexpr const char* pending_name = "/pending";
+
+    std::size_t length = std::strlen(database_path);
+    if (length + std::strlen(report_name) >= sizeof buffers->report_path) {
+        DEBUG_OUT("Database path is too long for the fallback writer; %s", database_path);
+        return false;
+    }
+
+    fallback_buffers* allocated = crashlytics::detail::memory::allocate_storage<fallback_buffers>();
+    if (allocated == nullptr) {
+        return false;
+    }
+
+    std::memcpy(allocated->report_path, database_path, length);
+    std::memcpy(allocated->report_path + length, report_name, std::strlen(report_name) + 1u);
+
+    std::memcpy(allocated->pending_path, database_path, length);
+    std::memcpy(allocated->pending_path + length, pending_name, std::strlen(pending_name) + 1u);
+
+    buffers = allocated;
+    refresh_fallback_baseline();
+
+    struct sigaction action;
+    std::memset(&action, 0, sizeof action);
+
+    action.sa_sigaction = fallback_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    for (std::size_t i = 0; i < fallback_signal_count; ++i) {
+        sigaction(fallback_signals[i], &action, &previous_actions[i]);
+    }
+
+    DEBUG_OUT("Fallback report will be written to %s", buffers->report_path);
+    return true;
+}
+
+void google::crashlytics::handler::detail::refresh_fallback_baseline()
+{
+    if (buffers == nullptr) {
+        return;
+    }
+
+    struct stat status;
+    buffers->baseline = ::stat(buffers->pending_path, &status) == 0 ? status.st_mtime : ::time(nullptr);
+}
@@ -12,18 +12,41 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <ctime>
 #include <string>
 #include <vector>
 
 #include <dlfcn.h>
+#include <pthread.h>
 
+#include <sys/resource.h>
 #include <sys/system_properties.h>
 
 #include "client/crashpad_client.h"
 
+#if defined (CRASHLYTICS_WARM_HANDLER_PROCESS)
+#    include <cerrno>
+#    include <sys/socket.h>
+#    include "util/file/file_io.h"
+#endif
+
 #include "crashlytics/config.h"
+#include "crashlytics/detail/trace.h"
 #include "crashlytics/handler/install.h"
 #include "crashlytics/handler/detail/context.h"
+#include "crashlytics/handler/detail/sampler.h"
+#if defined (CRASHLYTICS_LAST_RESORT_REPORT)
+#    include "crashlytics/handler/detail/fallback_writer.h"
+#endif
+#if defined (CRASHLYTICS_SHARED_HANDLER)
+#    include "crashlytics/handler/detail/shared_handler.h"
+#endif
+#include "crashlytics/handler/detail/prune.h"
+#include "crashlytics/external/detail/key_value_store.h"
+#include "crashlytics/external/detail/breadcrumb_store.h"
 #include "crashlytics/version.h"
 
 namespace google { namespace crashlytics { namespace detail {
@@ -46,6 +69,104 @@ void finalize()
     delete GetCrashpadClient();
 }
 
+//! Crashpad installation is split in two: a cheap synchronous phase on the
+//  thread initializing Firebase, and a deferred phase on a low-priority thread
+//  that does the expensive work (system property reads, dladdr/dlopen, env
+//  string building, the crashpad client start). The state below, together with
+//  a minimal pre-handler armed during the gap, makes sure a crash that lands
+//  before the deferred phase completes is still delivered to crashpad.
+enum installation_state : int {
+    InstallationNone = 0,
+    InstallationPending,
+    InstallationDone,
+    InstallationFailed
+};
+
+std::atomic<int> state { InstallationNone };
+
+constexpr int guarded_signals[] = { SIGABRT, SIGBUS, SIGFPE, SIGILL, SIGSEGV, SIGTRAP };
+constexpr std::size_t guarded_signal_count = sizeof guarded_signals / sizeof guarded_signals[0];
+
+//! The dispositions in place before the pre-handler was armed, indexed in step
+//  with guarded_signals. Restored before re-raising so the pre-install chain —
+//  typically debuggerd's tombstone handler — still runs.
+struct sigaction previous_actions[guarded_signal_count];
+
+void pre_handler(int signal, siginfo_t*, void*);
+
+const struct sigaction* previous_action_for(int signal)
+{
+    for (std::size_t i = 0; i < guarded_signal_count; ++i) {
+        if (guarded_signals[i] == signal) {
+            return &previous_actions[i];
+        }
+    }
+
+    return nullptr;
+}
+
+//! Puts back the disposition that was in place before arm_pre_handler ran, or
+//  the default when none was saved, so the re-raise below can't land here again.
+void restore_previous_action(int signal)
+{
+    if (const struct sigaction* previous = previous_action_for(signal)) {
+        sigaction(signal, previous, nullptr);
+        return;
+    }
+
+    struct sigaction default_action;
+    std::memset(&default_action, 0, sizeof default_action);
+    default_action.sa_handler = SIG_DFL;
+
+    sigaction(signal, &default_action, nullptr);
+}
+
+//! Armed for the installation gap only. Everything here is async-signal-safe:
+//  wait out the deferred phase (bounded), then hand the signal to whichever
+//  disposition should see it next. Crashpad also re-raises into the disposition
+//  it saved — this handler — after a successful dump, so whenever this handler
+//  is still the current one it must chain out rather than stay installed;
+//  raising with itself in place would re-deliver the signal here forever.
+void pre_handler(int signal, siginfo_t*, void*)
+{
+    constexpr int poll_iterations = 200;
+    constexpr long poll_interval_nanoseconds = 10L * 1000000L;
+
+    for (int iteration = 0; iteration != poll_iterations; ++iteration) {
+        if (state.load(std::memory_order_acquire) != InstallationPending) {
+            break;
+        }
+
+        timespec interval { 0, poll_interval_nanoseconds };
+        nanosleep(&interval, nullptr);
+    }
+
+    //! If installation finished during the wait, crashpad's sigaction replaced
+    //  this one and the raise below delivers straight to it; the disposition is
+    //  left untouched in that case.
+    struct sigaction current;
+    if (sigaction(signal, nullptr, &current) != 0 ||
+        ((current.sa_flags & SA_SIGINFO) != 0 && current.sa_sigaction == pre_handler)) {
+        restore_previous_action(signal);
+    }
+
+    raise(signal);
+}
+
+void arm_pre_handler()
+{
+    struct sigaction action;
+    std::memset(&action, 0, sizeof action);
+
+    action.sa_sigaction = pre_handler;
+    action.sa_flags = SA_SIGINFO;
+    sigemptyset(&action.sa_mask);
+
+    for (std::size_t i = 0; i < guarded_signal_count; ++i) {
+        sigaction(guarded_signals[i], &action, &previous_actions[i]);
+    }
+}
+
 } // namespace detail
 
 #if defined(__arm__) && defined(__ARM_ARCH_7A__)
@@ -72,6 +193,8 @@ void finalize()
 
 bool is_at_least_q()
 {
+    crashlytics::detail::scoped_trace trace("Crashlytics#IsAtLeastQ");
+
     char api_level[PROP_VALUE_MAX] = {};
     if (__system_property_get("ro.build.version.sdk", api_level) && atoi(api_level) >= 29) {
         DEBUG_OUT("API level is Q+; %s", api_level);
@@ -94,6 +217,8 @@ bool get_handler_trampoline(std::string& handler_trampoline, std::string& handle
         return false;
     }
 
+    crashlytics::detail::scoped_trace trace("Crashlytics#GetHandlerTrampoline");
+
     Dl_info info;
     if (dladdr(reinterpret_cast<void*>(&get_handler_trampoline), &info) == 0 ||
         dlsym(dlopen(info.dli_fname, RTLD_NOLOAD | RTLD_LAZY),
@@ -136,6 +261,8 @@ bool install_signal_handler_linker(
 
     DEBUG_OUT("Installing Crashpad handler via trampoline");
 
+    crashlytics::detail::scoped_trace trace("Crashlytics#StartHandlerWithLinkerAtCrash");
+
     return detail::GetCrashpadClient()->StartHandlerWithLinkerAtCrash(
         handler_trampoline, handler_library, 
         kUse64Bit, env, database, metrics_dir, url, annotations, arguments
@@ -157,39 +284,231 @@ bool install_signal_handler_java(
 
     DEBUG_OUT("Installing Java Crashpad handler");
 
+#if defined (CRASHLYTICS_LAST_RESORT_REPORT)
+    //! Crashpad restores the previous signal disposition and re-raises both
+    //  after a successful dump and when spawning an app_process from inside a
+    //  dying process fails. Installing the fallback writer first puts it next
+    //  in that chain; it writes a degraded in-process report only when no dump
+    //  was produced, then chains onward to the pre-install disposition.
+    if (!detail::install_fallback_writer(handler_context.filename)) {
+        DEBUG_OUT("No in-process fallback; a failed handler spawn loses the report");
+    }
+#endif
+
+    crashlytics::detail::scoped_trace trace("Crashlytics#StartJavaHandlerAtCrash");
+
     return detail::GetCrashpadClient()->StartJavaHandlerAtCrash(
         class_name, env, database, metrics_dir, url, annotations, arguments);
 }
 
+#if defined (CRASHLYTICS_WARM_HANDLER_PROCESS)
+//! Launches the handler process once, now, and parks it on its end of a socket
+//  pair; at crash time the signal handler only writes to the socket instead of
+//  forking an entire process — on pre-Q an entire app_process JVM — out of a
+//  dying, possibly OOM process.
+bool install_signal_handler_warm(
+    const std::vector<std::string>* env,
+    const detail::context& handler_context,
+    bool use_java_handler,
+    const std::string& handler_trampoline,
+    const std::string& handler_library)
+{
+    base::FilePath database { handler_context.filename };
+    base::FilePath metrics_dir;
+
+    std::string url;
+    std::map<std::string, std::string> annotations;
+    std::vector<std::string> arguments;
+
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) != 0) {
+        DEBUG_OUT("Couldn't create the handler socket pair; %s", strerror(errno));
+        return false;
+    }
+
+    DEBUG_OUT("Launching a warm %s handler", use_java_handler ? "Java" : "linker");
+
+    bool launched = use_java_handler
+        ? crashpad::CrashpadClient::StartJavaHandlerForClient(
+              "com/google/firebase/crashlytics/ndk/CrashpadMain",
+              env, database, metrics_dir, url, annotations, arguments, sockets[1])
+        : crashpad::CrashpadClient::StartHandlerWithLinkerForClient(
+              handler_trampoline, handler_library, kUse64Bit,
+              env, database, metrics_dir, url, annotations, arguments, sockets[1]);
+
+    //! The handler holds its own duplicate of its end by now.
+    ::close(sockets[1]);
+
+    if (!launched) {
+        DEBUG_OUT("Couldn't launch the warm handler; falling back to spawning at crash");
+        ::close(sockets[0]);
+        return false;
+    }
+
+#if defined (CRASHLYTICS_SHARED_HANDLER)
+    //! Best effort; failing to advertise only means sibling processes initialize on
+    //  their own, as they would without the shared mode.
+    if (!detail::advertise_shared_handler(handler_context.filename, sockets[0])) {
+        DEBUG_OUT("Couldn't advertise the handler socket to sibling processes");
+    }
+#endif
+
+    return detail::GetCrashpadClient()->SetHandlerSocket(crashpad::ScopedFileHandle(sockets[0]), -1);
+}
+#endif // CRASHLYTICS_WARM_HANDLER_PROCESS
+
+namespace detail {
+
+//! Sized up front so each entry costs exactly one allocation.
+std::string make_environment_entry(const char* key, const char* value)
+{
+    std::string entry;
+
+    entry.reserve(std::strlen(key) + std::strlen(value));
+    entry.append(key).append(value);
+
+    return entry;
+}
+
+} // namespace detail
+
 bool install_signal_handler(const detail::context& handler_context)
 {
+#if defined (CRASHLYTICS_SHARED_HANDLER)
+    //! A sibling process may have established the handler already; attaching is a
+    //  connect and one descriptor transfer instead of an env build and a spawn.
+    if (detail::attach_shared_handler(handler_context.filename)) {
+        return true;
+    }
+#endif
+
     std::string handler_trampoline;
     std::string handler_library;
-    std::string classpath = handler_context.classpath;
-    std::string lib_path = handler_context.lib_path;
 
-    std::vector<std::string> *env = new std::vector<std::string>;
+    crashlytics::detail::trace::begin("Crashlytics#BuildHandlerEnvironment");
+
+    //! Crashpad takes the env block by pointer and keeps it for the crash-time spawn,
+    //  so the vector deliberately lives for the duration of the process.
+    std::vector<std::string>* env = new std::vector<std::string>;
 
-    env->push_back("CLASSPATH=" + classpath);
-    env->push_back("LD_LIBRARY_PATH=" + lib_path);
+    env->reserve(3u);
+    env->push_back(detail::make_environment_entry("CLASSPATH=", handler_context.classpath));
+    env->push_back(detail::make_environment_entry("LD_LIBRARY_PATH=", handler_context.lib_path));
     env->push_back("ANDROID_DATA=/data");
 
+    crashlytics::detail::trace::end();
+
     bool use_java_handler = !get_handler_trampoline(handler_trampoline, handler_library);
 
+#if defined (CRASHLYTICS_WARM_HANDLER_PROCESS)
+    if (install_signal_handler_warm(env, handler_context, use_java_handler, handler_trampoline, handler_library)) {
+        return true;
+    }
+#endif
+
     return use_java_handler
         ? install_signal_handler_java(env, handler_context)
         : install_signal_handler_linker(env, handler_context, handler_trampoline, handler_library);
 }
 
+namespace detail {
+
+//! Entry point for the deferred phase. The crash handler isn't latency
+//  sensitive once the pre-handler is armed, so this stays out of the way of
+//  whatever else cold start is doing.
+void* install_deferred(void* opaque)
+{
+    setpriority(PRIO_PROCESS, 0, 10);
+
+    crashlytics::detail::trace::begin("Crashlytics#DeferredInstall");
+
+    context* handler_context = static_cast<context *>(opaque);
+    bool installed = install_signal_handler(*handler_context);
+
+    state.store(installed ? InstallationDone : InstallationFailed, std::memory_order_release);
+
+    if (installed) {
+        DEBUG_OUT("Deferred handler installation finished");
+    } else {
+        //! install_handlers has already returned by now; outside the installation
+        //  state, this is where a deferred-phase failure surfaces.
+        LOGE("Deferred crash handler installation failed");
+    }
+
+    //! Maintenance runs last: the handlers are armed, and nothing on this
+    //  thread is latency sensitive anymore.
+    prune_database(handler_context->filename);
+
+#if defined (CRASHLYTICS_LAST_RESORT_REPORT)
+    //! Pruning touches the pending directory; re-stamp the fallback baseline so
+    //  the writer doesn't mistake that for a dump.
+    refresh_fallback_baseline();
+#endif
+
+    crashlytics::detail::trace::end();
+
+    delete handler_context;
+    return nullptr;
+}
+
+} // namespace detail
+
 bool install_handlers(detail::context handler_context)
 {
+    crashlytics::detail::scoped_trace trace("Crashlytics#InstallHandlers");
+
     DEBUG_OUT("!!Crashlytics is in debug mode!!");
     DEBUG_OUT("Path is %s", handler_context.filename);
 
     atexit(detail::finalize);
 
+    //! The store is a crash-time snapshot for the NDK handler; custom keys
+    //  always cross into the JVM as well, which remains the system of record.
+    if (!api::detail::initialize_key_value_store(handler_context.filename)) {
+        DEBUG_OUT("Custom keys won't be captured natively");
+    }
+
+    if (!api::detail::initialize_breadcrumb_store(handler_context.filename)) {
+        DEBUG_OUT("Breadcrumbs won't be captured natively");
+    }
+
+#if defined (CRASHLYTICS_SYSTEM_INFO_SAMPLER)
+    if (!detail::start_system_info_sampler(handler_context.filename)) {
+        DEBUG_OUT("Device statistics will be collected at crash time");
+    }
+#endif
+
     LOGD("Initializing libcrashlytics version %s", VERSION);
-    return install_signal_handler(handler_context);
+
+    detail::state.store(detail::InstallationPending, std::memory_order_release);
+    detail::arm_pre_handler();
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+    //! The context's strings are owned by the JNI layer and live for the
+    //  duration of the process; the deferred phase only needs its own copy of
+    //  the struct. The JNIEnv pointer is thread-bound and is never touched on
+    //  the installation path.
+    detail::context* deferred_context = new detail::context(handler_context);
+
+    pthread_t thread;
+    int created = pthread_create(&thread, &attributes, detail::install_deferred, deferred_context);
+
+    pthread_attr_destroy(&attributes);
+
+    if (created != 0) {
+        DEBUG_OUT("Couldn't start the deferred installation thread; installing synchronously");
+        delete deferred_context;
+
+        bool installed = install_signal_handler(handler_context);
+        detail::state.store(installed ? detail::InstallationDone : detail::InstallationFailed, std::memory_order_release);
+
+        return installed;
+    }
+
+    return true;
 }
 
 }}}
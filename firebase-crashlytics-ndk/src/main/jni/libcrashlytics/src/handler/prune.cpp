@@ -0,0 +1,156 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "crashlytics/config.h"
+
+#include "crashlytics/handler/detail/prune.h"
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+namespace {
+
+//! Retention caps. Dumps beyond any of these are deleted oldest-first.
+constexpr std::size_t maximum_dump_count = 8u;
+constexpr off_t       maximum_total_bytes = 16 * 1024 * 1024;
+constexpr time_t      maximum_age_seconds = 7 * 24 * 60 * 60;
+
+struct entry {
+    std::string name;      //! File name within the directory.
+    std::string stem;      //! Name without its extension.
+    bool        dump;      //! True for minidumps (.dmp).
+    off_t       size;
+    time_t      modified;
+};
+
+void collect(const std::string& directory, std::vector<entry>& entries)
+{
+    DIR* handle = ::opendir(directory.c_str());
+    if (handle == nullptr) {
+        return;
+    }
+
+    while (struct dirent* node = ::readdir(handle)) {
+        if (node->d_name[0] == '.' && (node->d_name[1] == '\0' || (node->d_name[1] == '.' && node->d_name[2] == '\0'))) {
+            continue;
+        }
+
+        std::string path = directory + "/" + node->d_name;
+
+        struct stat status;
+        if (::stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode)) {
+            continue;
+        }
+
+        std::string name { node->d_name };
+        std::size_t extension = name.rfind('.');
+
+        entries.push_back({
+                name,
+                extension != std::string::npos ? name.substr(0, extension) : name,
+                extension != std::string::npos && name.compare(extension, std::string::npos, ".dmp") == 0,
+                status.st_size,
+                status.st_mtime
+        });
+    }
+
+    ::closedir(handle);
+}
+
+void prune_directory(const std::string& directory)
+{
+    std::vector<entry> entries;
+    collect(directory, entries);
+
+    std::vector<const entry *> dumps;
+    for (const entry& e : entries) {
+        if (e.dump) {
+            dumps.push_back(&e);
+        }
+    }
+
+    //! Newest first; everything that survives the caps is at the front.
+    std::sort(dumps.begin(), dumps.end(), [](const entry* lhs, const entry* rhs) {
+        return lhs->modified > rhs->modified;
+    });
+
+    time_t now = ::time(nullptr);
+    off_t  retained_bytes = 0;
+
+    std::vector<std::string> doomed_stems;
+
+    for (std::size_t i = 0; i < dumps.size(); ++i) {
+        retained_bytes += dumps[i]->size;
+
+        if (i >= maximum_dump_count ||
+            retained_bytes > maximum_total_bytes ||
+            now - dumps[i]->modified > maximum_age_seconds) {
+            doomed_stems.push_back(dumps[i]->stem);
+        }
+    }
+
+    if (doomed_stems.empty()) {
+        return;
+    }
+
+    std::size_t deleted = 0;
+
+    //! A dump's supplementary files share its stem; removing by stem takes
+    //  them out in the same pass.
+    for (const entry& e : entries) {
+        if (std::find(doomed_stems.begin(), doomed_stems.end(), e.stem) == doomed_stems.end()) {
+            continue;
+        }
+
+        std::string path = directory + "/" + e.name;
+
+        if (::unlink(path.c_str()) == 0) {
+            ++deleted;
+        }
+    }
+
+    DEBUG_OUT("Pruned %u file(s) from %s", static_cast<unsigned int>(deleted), directory.c_str());
+}
+
+} // anonymous namespace
+}}}}
+
+void google::crashlytics::handler::detail::prune_database(const char* database_path)
+{
+    std::string database { database_path };
+
+    //! Crashpad keeps dumps awaiting upload in pending/ and uploaded ones in
+    //  completed/; both grow without bound when uploads are deferred.
+    prune_directory(database + "/pending");
+    prune_directory(database + "/completed");
+
+    //! The last-resort report (see fallback_writer.cpp) has a fixed name and is
+    //  overwritten in place, so it only needs aging out, not counting.
+    std::string report = database + "/last_resort.native_crash";
+
+    struct stat status;
+    if (::stat(report.c_str(), &status) == 0 && ::time(nullptr) - status.st_mtime > maximum_age_seconds) {
+        ::unlink(report.c_str());
+    }
+}
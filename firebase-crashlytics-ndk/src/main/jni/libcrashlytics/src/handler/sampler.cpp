@@ -0,0 +1,150 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <string>
+#include <cerrno>
+
+#include <pthread.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/system_info.h"
+#include "crashlytics/detail/system_info_region.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+
+#include "crashlytics/handler/detail/sampler.h"
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+namespace {
+
+//! How long the sampler sleeps between refreshes. The statistics drift slowly,
+//  so a few seconds of staleness in a crash report is an acceptable trade for
+//  removing the I/O from the crash window.
+constexpr unsigned int sample_interval_seconds = 5u;
+
+std::atomic<google::crashlytics::detail::system_info_region *> region { nullptr };
+
+void refresh(google::crashlytics::detail::system_info_region* attached)
+{
+    google::crashlytics::detail::system_info_region::sample sample {};
+
+    //! The direct collectors, not the deadline-wrapped ones: this thread has no
+    //  latency budget to protect, and the wrapped variants would spawn a probe
+    //  thread per statistic on every refresh.
+    auto memory  = google::crashlytics::detail::memory_statistics_now();
+    auto storage = google::crashlytics::detail::internal_storage_statistics_now();
+
+    sample.total_physical_memory      = memory.first;
+    sample.available_physical_memory  = memory.second;
+    sample.total_internal_storage     = storage.first;
+    sample.available_internal_storage = storage.second;
+    sample.battery                    = static_cast<uint64_t>(google::crashlytics::detail::battery_capacity_now());
+
+    attached->publish(sample);
+}
+
+void* sample_periodically(void*)
+{
+    google::crashlytics::detail::system_info_region* attached;
+
+    while ((attached = region.load(std::memory_order_acquire)) != nullptr) {
+        refresh(attached);
+        ::sleep(sample_interval_seconds);
+    }
+
+    return nullptr;
+}
+
+bool start_sampler_thread()
+{
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+    pthread_t thread;
+    int result = pthread_create(&thread, &attributes, sample_periodically, nullptr);
+
+    pthread_attr_destroy(&attributes);
+
+    if (result != 0) {
+        DEBUG_OUT("Couldn't start the system-info sampler; %s", strerror(result));
+        return false;
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+}}}}
+
+bool google::crashlytics::handler::detail::start_system_info_sampler(const char* database_path)
+{
+    using google::crashlytics::detail::system_info_region;
+    using google::crashlytics::detail::system_info_region_name;
+
+    if (region.load(std::memory_order_acquire) != nullptr) {
+        return true;
+    }
+
+    std::string path { database_path };
+    path += "/";
+    path += system_info_region_name();
+
+    int fd;
+    if ((fd = RECOVER_FROM_INTERRUPT(::open(path.c_str(), O_RDWR | O_CREAT, 0600))) == -1) {
+        DEBUG_OUT("Couldn't open system-info region '%s'; %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (::ftruncate(fd, sizeof (system_info_region)) == -1) {
+        DEBUG_OUT("Couldn't size system-info region '%s'; %s", path.c_str(), strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = ::mmap(nullptr, sizeof (system_info_region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if (mapped == MAP_FAILED) {
+        DEBUG_OUT("Couldn't map system-info region '%s'; %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    system_info_region* mapped_region = static_cast<system_info_region *>(mapped);
+
+    //! Several app processes may race here; initialize() publishes the magic
+    //  with a release store over zeroed buffers, so a duplicate stamp is harmless.
+    if (!mapped_region->valid()) {
+        mapped_region->initialize();
+    }
+
+    system_info_region* expected = nullptr;
+    if (!region.compare_exchange_strong(expected, mapped_region, std::memory_order_release)) {
+        ::munmap(mapped, sizeof (system_info_region));
+        return true;
+    }
+
+    //! Publish one sample synchronously so a crash that lands before the first
+    //  periodic refresh still finds a snapshot.
+    refresh(mapped_region);
+
+    DEBUG_OUT("System-info region is at %s", path.c_str());
+    return start_sampler_thread();
+}
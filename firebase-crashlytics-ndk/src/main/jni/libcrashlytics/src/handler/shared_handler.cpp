@@ -0,0 +1,260 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cerrno>
+#include <cstring>
+
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <sys/file.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "client/crashpad_client.h"
+
+#include "crashlytics/config.h"
+#include "crashlytics/detail/recover_from_interrupt.h"
+
+#include "crashlytics/handler/detail/shared_handler.h"
+
+namespace google { namespace crashlytics { namespace handler { namespace detail {
+
+extern crashpad::CrashpadClient* GetCrashpadClient();
+
+namespace {
+
+constexpr char socket_name[] = "/.handler_socket";
+constexpr char lock_name[]   = "/.handler_lock";
+
+bool socket_address(const char* database_path, sockaddr_un& address)
+{
+    std::size_t length = std::strlen(database_path);
+
+    if (length + sizeof socket_name > sizeof address.sun_path) {
+        DEBUG_OUT("Database path is too long for a socket address; %s", database_path);
+        return false;
+    }
+
+    std::memset(&address, 0, sizeof address);
+    address.sun_family = AF_UNIX;
+
+    std::memcpy(address.sun_path, database_path, length);
+    std::memcpy(address.sun_path + length, socket_name, sizeof socket_name);
+
+    return true;
+}
+
+//! Only one process per database may advertise; the lock is held for the life of the
+//  winning process, so the descriptor is deliberately never closed.
+bool acquire_advertiser_lock(const char* database_path)
+{
+    char lock_path[sizeof (sockaddr_un::sun_path)];
+
+    std::size_t length = std::strlen(database_path);
+
+    if (length + sizeof lock_name > sizeof lock_path) {
+        return false;
+    }
+
+    std::memcpy(lock_path, database_path, length);
+    std::memcpy(lock_path + length, lock_name, sizeof lock_name);
+
+    int fd = RECOVER_FROM_INTERRUPT(::open(lock_path, O_WRONLY | O_CREAT | O_CLOEXEC, 0600));
+
+    if (fd == -1) {
+        DEBUG_OUT("Couldn't open the advertiser lock; %s", strerror(errno));
+        return false;
+    }
+
+    if (::flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        DEBUG_OUT("Another process holds the advertiser lock");
+        ::close(fd);
+        return false;
+    }
+
+    return true;
+}
+
+int receive_handler_socket(int connection)
+{
+    char byte = 0;
+    char control[CMSG_SPACE(sizeof (int))] = {};
+
+    iovec vector { &byte, 1u };
+
+    msghdr message = {};
+    message.msg_iov        = &vector;
+    message.msg_iovlen     = 1u;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof control;
+
+    if (RECOVER_FROM_INTERRUPT(::recvmsg(connection, &message, 0)) <= 0) {
+        DEBUG_OUT("Couldn't receive the handler socket; %s", strerror(errno));
+        return -1;
+    }
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+
+    if (header == nullptr || header->cmsg_level != SOL_SOCKET || header->cmsg_type != SCM_RIGHTS) {
+        DEBUG_OUT("The advertiser sent no descriptor");
+        return -1;
+    }
+
+    int handler_socket = -1;
+    std::memcpy(&handler_socket, CMSG_DATA(header), sizeof handler_socket);
+
+    return handler_socket;
+}
+
+void send_handler_socket(int connection, int handler_socket)
+{
+    char byte = 0;
+    char control[CMSG_SPACE(sizeof (int))] = {};
+
+    iovec vector { &byte, 1u };
+
+    msghdr message = {};
+    message.msg_iov        = &vector;
+    message.msg_iovlen     = 1u;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof control;
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type  = SCM_RIGHTS;
+    header->cmsg_len   = CMSG_LEN(sizeof handler_socket);
+
+    std::memcpy(CMSG_DATA(header), &handler_socket, sizeof handler_socket);
+
+    if (RECOVER_FROM_INTERRUPT(::sendmsg(connection, &message, 0)) == -1) {
+        DEBUG_OUT("Couldn't send the handler socket; %s", strerror(errno));
+    }
+}
+
+struct broker_context {
+    int listener;
+    int handler_socket;
+};
+
+//! Serves a duplicate of the handler socket to every sibling that connects, for the
+//  life of the process.
+void* broker(void* opaque)
+{
+    broker_context* context = static_cast<broker_context *>(opaque);
+
+    for (;;) {
+        int connection = RECOVER_FROM_INTERRUPT(::accept(context->listener, nullptr, nullptr));
+
+        if (connection == -1) {
+            DEBUG_OUT("The advertised socket is gone; %s", strerror(errno));
+            break;
+        }
+
+        send_handler_socket(connection, context->handler_socket);
+        ::close(connection);
+    }
+
+    return nullptr;
+}
+
+} // anonymous namespace
+
+bool attach_shared_handler(const char* database_path)
+{
+    sockaddr_un address;
+
+    if (!socket_address(database_path, address)) {
+        return false;
+    }
+
+    int connection = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (connection == -1) {
+        DEBUG_OUT("Couldn't create a socket; %s", strerror(errno));
+        return false;
+    }
+
+    if (RECOVER_FROM_INTERRUPT(
+            ::connect(connection, reinterpret_cast<sockaddr *>(&address), sizeof address)) != 0) {
+        DEBUG_OUT("No advertised handler to attach to; %s", strerror(errno));
+        ::close(connection);
+        return false;
+    }
+
+    int handler_socket = receive_handler_socket(connection);
+    ::close(connection);
+
+    if (handler_socket == -1) {
+        return false;
+    }
+
+    DEBUG_OUT("Attached to the handler established by a sibling process");
+    return GetCrashpadClient()->SetHandlerSocket(crashpad::ScopedFileHandle(handler_socket), -1);
+}
+
+bool advertise_shared_handler(const char* database_path, int handler_socket)
+{
+    sockaddr_un address;
+
+    if (!socket_address(database_path, address) || !acquire_advertiser_lock(database_path)) {
+        return false;
+    }
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (listener == -1) {
+        DEBUG_OUT("Couldn't create the advertised socket; %s", strerror(errno));
+        return false;
+    }
+
+    //! A socket file left over from a previous run would make bind fail; holding the
+    //  advertiser lock means nobody is serving it, so it is stale.
+    ::unlink(address.sun_path);
+
+    if (::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof address) != 0 ||
+        ::listen(listener, 4) != 0) {
+        DEBUG_OUT("Couldn't advertise the handler socket; %s", strerror(errno));
+        ::close(listener);
+        return false;
+    }
+
+    broker_context* context = new broker_context { listener, ::dup(handler_socket) };
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+
+    pthread_t thread;
+    int created = pthread_create(&thread, &attributes, broker, context);
+
+    pthread_attr_destroy(&attributes);
+
+    if (created != 0) {
+        DEBUG_OUT("Couldn't start the broker thread");
+        ::close(context->handler_socket);
+        ::close(listener);
+        ::unlink(address.sun_path);
+
+        delete context;
+        return false;
+    }
+
+    DEBUG_OUT("Advertising the handler socket to sibling processes");
+    return true;
+}
+
+}}}} // namespace google::crashlytics::handler::detail
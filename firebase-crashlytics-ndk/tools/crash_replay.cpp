@@ -0,0 +1,286 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Linux-host crash replay harness. Spawns a synthetic crashing child with a
+//  configurable amount of heap, threads and extra mappings; the child attaches
+//  the given crashpad handler executable through the crashpad client before it
+//  crashes, so the at-crash spawn and the walk of the synthetic state are both
+//  inside the measured window, the way a production capture is. Reports
+//  capture-latency (go byte to the dump appearing under pending/) and
+//  dump-size distributions over N iterations. Lets CI catch handler-pipeline
+//  regressions without a device farm.
+//
+//  Build on a host machine from a crashpad checkout (the client library is
+//  required to attach the handler to the child), with -I<crashpad> and
+//  -I<crashpad>/third_party/mini_chromium/mini_chromium on the include path:
+//      c++ -std=c++17 -pthread -o crash_replay crash_replay.cpp <crashpad client/util/base libs>
+//
+//  Usage:
+//      crash_replay [--iterations N] [--heap-mb M] [--threads T]
+//                   [--mappings K] [--database DIR] [--handler PATH]
+//
+//  PATH is a crashpad_handler executable (or anything wrapping
+//  CrashpadHandlerMain); when omitted, only the crash-to-reap latency of the
+//  synthetic child is measured.
+
+#include <algorithm>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "client/crashpad_client.h"
+
+namespace {
+
+struct options {
+    int         iterations = 10;
+    std::size_t heap_mb    = 64;
+    int         threads    = 4;
+    int         mappings   = 64;
+    std::string database   = "/tmp/crash_replay.db";
+    std::string handler;
+};
+
+uint64_t now_nanoseconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000u + static_cast<uint64_t>(now.tv_nsec);
+}
+
+void* park(void* opaque)
+{
+    //! Synthetic threads exist only to give the capture more state to walk.
+    pause();
+    return nullptr;
+}
+
+//! Builds the synthetic process state, attaches the handler, reports
+//  readiness, waits for the go byte, and crashes. Never returns. The handler
+//  must be attached before the ready byte: the capture window starts at the
+//  go byte, so the at-crash handler spawn and the ptrace walk of the synthetic
+//  state land inside it, the way they would in production.
+[[noreturn]] void run_child(const options& opts, int ready_fd, int go_fd)
+{
+    std::size_t heap_bytes = opts.heap_mb * 1024u * 1024u;
+    char* heap = static_cast<char*>(std::malloc(heap_bytes));
+
+    if (heap != nullptr) {
+        for (std::size_t offset = 0; offset < heap_bytes; offset += 4096u) {
+            heap[offset] = static_cast<char>(offset);
+        }
+    }
+
+    for (int i = 0; i < opts.mappings; ++i) {
+        void* mapping = mmap(nullptr, 4096u, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping != MAP_FAILED) {
+            *static_cast<char*>(mapping) = static_cast<char>(i);
+        }
+    }
+
+    for (int i = 0; i < opts.threads; ++i) {
+        pthread_t thread;
+        pthread_create(&thread, nullptr, park, nullptr);
+    }
+
+    if (!opts.handler.empty()) {
+        crashpad::CrashpadClient client;
+
+        if (!client.StartHandlerAtCrash(
+                base::FilePath { opts.handler },
+                base::FilePath { opts.database },
+                base::FilePath {},
+                std::string {},
+                std::map<std::string, std::string> {},
+                std::vector<std::string> {})) {
+            std::fprintf(stderr, "error: couldn't attach the handler\n");
+            _exit(2);
+        }
+    }
+
+    char byte = 'r';
+    (void) !write(ready_fd, &byte, 1);
+    (void) !read(go_fd, &byte, 1);
+
+    raise(SIGSEGV);
+    _exit(1);
+}
+
+//! Total size of regular files under <database>/pending, as a proxy for the
+//  dump the handler produced this iteration.
+uint64_t pending_bytes(const std::string& database)
+{
+    uint64_t total = 0;
+    std::string pending = database + "/pending";
+
+    if (DIR* handle = opendir(pending.c_str())) {
+        while (struct dirent* node = readdir(handle)) {
+            std::string path = pending + "/" + node->d_name;
+
+            struct stat status;
+            if (stat(path.c_str(), &status) == 0 && S_ISREG(status.st_mode)) {
+                total += static_cast<uint64_t>(status.st_size);
+            }
+        }
+        closedir(handle);
+    }
+
+    return total;
+}
+
+void report(const char* label, std::vector<uint64_t> samples, double scale, const char* unit)
+{
+    if (samples.empty()) {
+        return;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    auto at = [&](double quantile) {
+        return samples[static_cast<std::size_t>(quantile * (samples.size() - 1))] / scale;
+    };
+
+    std::printf("%-16s min %9.2f  p50 %9.2f  p90 %9.2f  max %9.2f  %s\n",
+                label, at(0.0), at(0.5), at(0.9), at(1.0), unit);
+}
+
+bool parse(int argc, char* argv[], options& opts)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (argument == "--iterations" && value) { opts.iterations = std::atoi(value);  ++i; }
+        else if (argument == "--heap-mb"  && value) { opts.heap_mb  = std::strtoul(value, nullptr, 10); ++i; }
+        else if (argument == "--threads"  && value) { opts.threads  = std::atoi(value); ++i; }
+        else if (argument == "--mappings" && value) { opts.mappings = std::atoi(value); ++i; }
+        else if (argument == "--database" && value) { opts.database = value; ++i; }
+        else if (argument == "--handler"  && value) { opts.handler  = value; ++i; }
+        else {
+            std::fprintf(stderr,
+                    "usage: %s [--iterations N] [--heap-mb M] [--threads T]"
+                    " [--mappings K] [--database DIR] [--handler PATH]\n", argv[0]);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    options opts;
+    if (!parse(argc, argv, opts)) {
+        return 1;
+    }
+
+    mkdir(opts.database.c_str(), 0755);
+    mkdir((opts.database + "/pending").c_str(), 0755);
+
+    std::vector<uint64_t> latencies;
+    std::vector<uint64_t> dump_sizes;
+
+    for (int iteration = 0; iteration < opts.iterations; ++iteration) {
+        int ready_pipe[2];
+        int go_pipe[2];
+
+        if (pipe(ready_pipe) != 0 || pipe(go_pipe) != 0) {
+            std::perror("pipe");
+            return 1;
+        }
+
+        uint64_t pending_before = pending_bytes(opts.database);
+
+        pid_t child = fork();
+        if (child == 0) {
+            close(ready_pipe[0]);
+            close(go_pipe[1]);
+            run_child(opts, ready_pipe[1], go_pipe[0]);
+        }
+
+        close(ready_pipe[1]);
+        close(go_pipe[0]);
+
+        char byte;
+        if (read(ready_pipe[0], &byte, 1) != 1) {
+            std::fprintf(stderr, "error: child never became ready\n");
+            return 1;
+        }
+
+        byte = 'g';
+        uint64_t started = now_nanoseconds();
+        (void) !write(go_pipe[1], &byte, 1);
+
+        uint64_t finished;
+        int      status = 0;
+
+        if (!opts.handler.empty()) {
+            //! The database moves a dump into pending/ only once the handler
+            //  has finished writing it, so growth there marks the end of the
+            //  capture. The child is reaped afterwards -- the handler holds it
+            //  under ptrace until the walk is done, well past the go byte.
+            uint64_t deadline = started + 30u * 1000000000ull;
+
+            while (pending_bytes(opts.database) <= pending_before && now_nanoseconds() < deadline) {
+                usleep(200u);
+            }
+
+            finished = now_nanoseconds();
+
+            if (pending_bytes(opts.database) <= pending_before) {
+                std::fprintf(stderr, "warning: no dump appeared on iteration %d\n", iteration);
+            }
+
+            waitpid(child, &status, 0);
+        }
+        else {
+            waitpid(child, &status, 0);
+            finished = now_nanoseconds();
+        }
+
+        latencies.push_back(finished - started);
+        dump_sizes.push_back(pending_bytes(opts.database) - pending_before);
+
+        close(ready_pipe[0]);
+        close(go_pipe[1]);
+    }
+
+    std::printf("%d iteration(s), heap %zu MB, %d thread(s), %d mapping(s)%s\n",
+                opts.iterations, opts.heap_mb, opts.threads, opts.mappings,
+                opts.handler.empty() ? " (no handler; reap latency only)" : "");
+
+    report("capture latency", latencies, 1e6, "ms");
+    report("dump size", dump_sizes, 1024.0, "KiB");
+
+    return 0;
+}
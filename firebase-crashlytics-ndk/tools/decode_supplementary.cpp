@@ -0,0 +1,200 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//! Offline decoder for supplementary files written in the compact binary format
+//  (CRASHLYTICS_BINARY_SUPPLEMENTARY_FILES); prints the equivalent JSON to stdout.
+//  The record layout is documented in
+//  src/main/jni/libcrashlytics-common/include/crashlytics/detail/binary_writer.h.
+//
+//  Build on a host machine with:
+//      c++ -std=c++17 -o decode_supplementary decode_supplementary.cpp
+//
+//  Usage:
+//      decode_supplementary <file> [<file> ...]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum Tag : uint8_t {
+    Uint64     = 1,
+    Bool       = 2,
+    String     = 3,
+    BeginGroup = 4,
+    EndGroup   = 5
+};
+
+struct reader {
+    explicit reader(std::FILE* file) : file_(file), failed_(false) {}
+
+    uint8_t u8()
+    {
+        int c = std::fgetc(file_);
+        if (c == EOF) {
+            failed_ = true;
+            return 0;
+        }
+        return static_cast<uint8_t>(c);
+    }
+
+    uint16_t u16() { uint16_t low = u8(); return static_cast<uint16_t>(low | (u8() << 8)); }
+
+    uint64_t u64()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 8) {
+            value |= static_cast<uint64_t>(u8()) << shift;
+        }
+        return value;
+    }
+
+    std::string bytes(std::size_t length)
+    {
+        std::string value(length, '\0');
+        if (length != 0 && std::fread(&value[0], 1, length, file_) != length) {
+            failed_ = true;
+        }
+        return value;
+    }
+
+    bool eof() const { return std::feof(file_) != 0; }
+    bool failed() const { return failed_; }
+
+private:
+    std::FILE* file_;
+    bool       failed_;
+};
+
+void print_quoted(const std::string& value)
+{
+    std::fputc('"', stdout);
+    std::fwrite(value.data(), 1, value.size(), stdout);
+    std::fputc('"', stdout);
+}
+
+bool decode(std::FILE* file)
+{
+    reader input(file);
+
+    char magic[4] = {
+        static_cast<char>(input.u8()), static_cast<char>(input.u8()),
+        static_cast<char>(input.u8()), static_cast<char>(input.u8())
+    };
+
+    if (std::memcmp(magic, "CLSF", 4) != 0) {
+        std::fprintf(stderr, "error: not a binary supplementary file\n");
+        return false;
+    }
+
+    //! Version 2 added a one-byte kind payload to BeginGroup records; version 1
+    //  files predate it, and every group decodes as an object.
+    uint8_t version = input.u8();
+    if (version != 1 && version != 2) {
+        std::fprintf(stderr, "error: unsupported version %u\n", version);
+        return false;
+    }
+
+    bool first = true;
+    std::vector<char> closers;
+
+    for (;;) {
+        uint8_t tag = input.u8();
+        if (input.eof()) {
+            break;
+        }
+
+        std::string key = input.bytes(input.u8());
+
+        if (!first && tag != EndGroup) {
+            std::fputc(',', stdout);
+        }
+        first = false;
+
+        if (!key.empty()) {
+            print_quoted(key);
+            std::fputc(':', stdout);
+        }
+
+        switch (tag) {
+        case Uint64:
+            std::fprintf(stdout, "%llu", static_cast<unsigned long long>(input.u64()));
+            break;
+        case Bool:
+            std::fputs(input.u8() != 0 ? "true" : "false", stdout);
+            break;
+        case String:
+            print_quoted(input.bytes(input.u16()));
+            break;
+        case BeginGroup: {
+            char open = version >= 2 ? static_cast<char>(input.u8()) : '{';
+
+            std::fputc(open == '[' ? '[' : '{', stdout);
+            closers.push_back(open == '[' ? ']' : '}');
+            first = true;
+            break;
+        }
+        case EndGroup:
+            std::fputc(closers.empty() ? '}' : closers.back(), stdout);
+            if (!closers.empty()) {
+                closers.pop_back();
+            }
+            break;
+        default:
+            std::fprintf(stderr, "error: unknown record tag %u\n", tag);
+            return false;
+        }
+
+        if (input.failed()) {
+            std::fprintf(stderr, "error: truncated file\n");
+            return false;
+        }
+    }
+
+    std::fputc('\n', stdout);
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <file> [<file> ...]\n", argv[0]);
+        return 1;
+    }
+
+    int status = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::FILE* file = std::fopen(argv[i], "rb");
+
+        if (file == nullptr) {
+            std::fprintf(stderr, "error: couldn't open %s\n", argv[i]);
+            status = 1;
+            continue;
+        }
+
+        if (!decode(file)) {
+            status = 1;
+        }
+
+        std::fclose(file);
+    }
+
+    return status;
+}